@@ -0,0 +1,314 @@
+/**
+ * @file anytime.cpp
+ * @author Bastien
+ * @brief Class for the solver that gives its best answer before a deadline (Implementation File)
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+#include "anytime.h"
+#include "log.h"
+#include "parallel.h"
+#include <algorithm>
+#include <climits>
+
+/**
+ * @brief Construct a new AnytimeSolver:: AnytimeSolver object
+ *
+ * @param b The board to solve, its current snapshot is used
+ */
+AnytimeSolver::AnytimeSolver(Board* b) : AnytimeSolver(b->getSnapshot()){
+}
+
+/**
+ * @brief Construct a new AnytimeSolver:: AnytimeSolver object
+ *
+ * @param b The snapshot of the board to solve
+ */
+AnytimeSolver::AnytimeSolver(shared_ptr<const BoardSnapshot> b){
+    this->board = b;
+    this->exact = make_shared<BidirectionalSolver>(b);
+    this->lowerBound = 0;
+    this->upperBound = INT_MAX;
+}
+
+/**
+ * @brief The setProgress function sets the function called each time a bound improves
+ *
+ * @param progress Called with the lower and the upper bound, from the thread running the search
+ */
+void AnytimeSolver::setProgress(function<void(int, int)> progress){
+    this->progress = progress;
+}
+
+/**
+ * @brief The getLowerBound function returns the number of moves the last search proved the round needs at least
+ *
+ * @return The bound, or INT_MAX if the target cannot be reached
+ */
+int AnytimeSolver::getLowerBound() const{
+    return this->lowerBound;
+}
+
+/**
+ * @brief The getUpperBound function returns the number of moves of the best solution of the last search
+ *
+ * @return The bound, or INT_MAX if no solution was found
+ */
+int AnytimeSolver::getUpperBound() const{
+    return this->upperBound;
+}
+
+/**
+ * @brief The isOptimal function checks if the last search proved its solution optimal, or proved that there is none
+ *
+ * @return true
+ * @return false
+ */
+bool AnytimeSolver::isOptimal() const{
+    return this->lowerBound == this->upperBound;
+}
+
+/**
+ * @brief The getExactSolver function returns the bidirectional solver of the exact search, with the searches of the last solve
+ *
+ * @return shared_ptr<const BidirectionalSolver>
+ */
+shared_ptr<const BidirectionalSolver> AnytimeSolver::getExactSolver() const{
+    return this->exact;
+}
+
+/**
+ * @brief The report function records new bounds and calls the progress callback if they changed
+ *
+ * @param lower
+ * @param upper
+ */
+void AnytimeSolver::report(int lower, int upper){
+    if(lower == this->lowerBound && upper == this->upperBound){
+        return;
+    }
+    this->lowerBound = lower;
+    this->upperBound = upper;
+    log(LogLevel::DEBUG, "Anytime solver bounds: " + to_string(lower) + " to " + (upper == INT_MAX ? string("unknown") : to_string(upper)) + " moves");
+    if(this->progress){
+        this->progress(lower, upper);
+    }
+}
+
+/**
+ * @brief The solve function gives the best solution of the current round found before a deadline
+ * @details Same goal as Solver::solve: the robot matching the color of the objective tile has to reach it, or any robot if the objective tile is multicolored.
+ *
+ * @param robots The robots of the game
+ * @param objectiveTile The objective tile
+ * @param deadline The time to give an answer by
+ * @param token The search stops when a stop is requested on it
+ * @return Solution
+ */
+Solution AnytimeSolver::solve(Robot* robots[ROBOT_COUNT], Tile* objectiveTile, chrono::steady_clock::time_point deadline, stop_token token){
+    int cells[ROBOT_COUNT];
+    int targetRobot = -1;
+    for(int i = 0; i < ROBOT_COUNT; i++){
+        cells[i] = robots[i]->getCell();
+        if(robots[i]->getColor() == objectiveTile->getTargetColor()){
+            targetRobot = i;
+        }
+    }
+    int targetCell = robots[0]->getBoard()->getCell(objectiveTile);
+    return this->solve(Solver::packState(cells), targetCell, targetRobot, deadline, token);
+}
+
+/**
+ * @brief The solve function gives the best solution found from a start state before a deadline
+ * @details getLowerBound and getUpperBound give the bounds reached, the solution has getUpperBound moves when it is solved.
+ *
+ * @param start The start state
+ * @param targetCell The cell to reach
+ * @param targetRobot The robot that has to reach the cell, or -1 if any robot can reach it
+ * @param deadline The time to give an answer by
+ * @param token The search stops when a stop is requested on it
+ * @return The best solution found, not solved if none was found in time or if there is none
+ */
+Solution AnytimeSolver::solve(State start, int targetCell, int targetRobot, chrono::steady_clock::time_point deadline, stop_token token){
+    this->lowerBound = 0;
+    this->upperBound = INT_MAX;
+    Solution best;
+    best.solved = false;
+    best.nodes = 0;
+
+    int width = ANYTIME_BEAM_WIDTH;
+    Solution beam = this->beamSearch(start, targetCell, targetRobot, width, token, deadline);
+    best.nodes += beam.nodes;
+    if(beam.solved){
+        best.solved = true;
+        best.moves = beam.moves;
+        this->report(0, beam.moves.size());
+    }
+
+    if(token.stop_requested() || chrono::steady_clock::now() >= deadline){
+        return best;
+    }
+    BidirectionalSolver& exact = *this->exact;
+    exact.setStop(token, deadline);
+    exact.setMaxDepth(this->upperBound == INT_MAX ? INT_MAX : this->upperBound - 1);
+    exact.setProgress([&](int bound){
+        this->report(max(this->lowerBound, min(bound, this->upperBound)), this->upperBound);
+        // A wider beam may find a shorter solution before the next, longer, level
+        if(this->lowerBound < this->upperBound && width < ANYTIME_MAX_BEAM_WIDTH){
+            width *= 4;
+            Solution wider = this->beamSearch(start, targetCell, targetRobot, width, token, deadline);
+            best.nodes += wider.nodes;
+            if(wider.solved && wider.moves.size() < this->upperBound){
+                best.moves = wider.moves;
+                best.solved = true;
+                this->report(this->lowerBound, wider.moves.size());
+                exact.setMaxDepth(this->upperBound - 1);
+            }
+        }
+    });
+    Solution solution = exact.solve(start, targetCell, targetRobot);
+    best.nodes += solution.nodes;
+    if(solution.solved){
+        best.solved = true;
+        best.moves = solution.moves;
+        this->report(solution.moves.size(), solution.moves.size());
+    }else{
+        // Searched up to the upper bound without a shorter solution, or stopped
+        this->report(max(this->lowerBound, min(exact.getLowerBound(), this->upperBound)), this->upperBound);
+    }
+    if(exact.isCancelled()){
+        log(LogLevel::DEBUG, "Anytime solver stopped with " + to_string(this->lowerBound) + " to " + (this->upperBound == INT_MAX ? string("unknown") : to_string(this->upperBound)) + " moves after " + to_string(best.nodes) + " nodes");
+    }
+    return best;
+}
+
+/**
+ * @brief The beamSearch function looks for a solution keeping only the most promising states of each level
+ * @details States are ranked by the distance of the closest eligible robot to the target, ties by state so that the result does not depend on the order of the moves. The search stops at the first goal state, or when a level cannot beat the current upper bound.
+ *
+ * @param start The start state
+ * @param targetCell The cell to reach
+ * @param targetRobot The robot that has to reach the cell, or -1 if any robot can reach it
+ * @param width The number of states kept at each level
+ * @param token The search stops when a stop is requested on it
+ * @param deadline The search stops when this time is reached
+ * @return Solution, solved if a goal was reached
+ */
+Solution AnytimeSolver::beamSearch(State start, int targetCell, int targetRobot, int width, const stop_token& token, chrono::steady_clock::time_point deadline){
+    Solution solution;
+    solution.solved = false;
+    solution.nodes = 0;
+
+    int target = this->board->findTarget(targetCell);
+    vector<unsigned char> distances[ROBOT_COUNT];
+    for(int i = 0; i < ROBOT_COUNT; i++){
+        if(targetRobot != -1 && targetRobot != i){
+            continue;
+        }
+        if(target == -1){
+            this->board->computeDistances(targetCell, i, distances[i]);
+            continue;
+        }
+        distances[i].resize(CELL_COUNT);
+        for(int cell = 0; cell < CELL_COUNT; cell++){
+            distances[i][cell] = this->board->getDistance(target, i, cell);
+        }
+    }
+    auto estimate = [&](State state){
+        int distance = UNREACHABLE;
+        for(int i = 0; i < ROBOT_COUNT; i++){
+            if(!distances[i].empty()){
+                distance = min(distance, (int)distances[i][Solver::getRobotCell(state, i)]);
+            }
+        }
+        return distance;
+    };
+
+    // The states kept at each level, with the place of their parent in the level before
+    struct Node{
+        State state;
+        int parent;
+        unsigned char move;
+    };
+    struct Candidate{
+        int distance;
+        Node node;
+    };
+    vector<vector<Node>> levels(1, vector<Node>(1, {start, -1, 0}));
+    VisitedSet visited(ANYTIME_VISITED_CAPACITY);
+    visited.insert(start, 0);
+    visited.addCount(1);
+    Node goal = levels[0][0];
+    bool found = estimate(start) == 0;
+    vector<Candidate> candidates;
+    State successors[EXPAND_BATCH_SIZE * MOVE_COUNT];
+    for(int depth = 1; !found && !levels.back().empty() && depth < this->upperBound; depth++){
+        const vector<Node>& level = levels.back();
+        candidates.clear();
+        for(size_t i = 0; i < level.size() && !found; i += EXPAND_BATCH_SIZE){
+            // The stop is checked about as often as by the bidirectional solver
+            if(i % BIDIRECTIONAL_CHECK_INTERVAL == 0 && (token.stop_requested() || chrono::steady_clock::now() >= deadline)){
+                return solution;
+            }
+            while(visited.size() + EXPAND_BATCH_SIZE * MOVE_COUNT > visited.getCapacity() / 2){
+                visited.grow();
+            }
+            State states[EXPAND_BATCH_SIZE];
+            int count = min(level.size() - i, (size_t)EXPAND_BATCH_SIZE);
+            for(int j = 0; j < count; j++){
+                states[j] = level[i + j].state;
+            }
+            this->board->expand(states, count, successors);
+            solution.nodes += count;
+            size_t added = 0;
+            for(int j = 0; j < count * MOVE_COUNT; j++){
+                if(successors[j] == states[j / MOVE_COUNT] || !visited.insert(successors[j], depth)){
+                    continue;
+                }
+                added++;
+                Node node = {successors[j], (int)(i + j / MOVE_COUNT), (unsigned char)(j % MOVE_COUNT)};
+                int distance = estimate(successors[j]);
+                if(distance == 0){
+                    found = true;
+                    goal = node;
+                    break;
+                }
+                // A state that cannot reach the target, or not in fewer moves than the best solution, is dropped
+                if(distance != UNREACHABLE && depth + distance < this->upperBound){
+                    candidates.push_back({distance, node});
+                }
+            }
+            visited.addCount(added);
+        }
+        if(found){
+            break;
+        }
+        auto closer = [](const Candidate& a, const Candidate& b){
+            return a.distance < b.distance || (a.distance == b.distance && a.node.state < b.node.state);
+        };
+        if(candidates.size() > width){
+            nth_element(candidates.begin(), candidates.begin() + width, candidates.end(), closer);
+            candidates.resize(width);
+        }
+        vector<Node> next;
+        for(const Candidate& candidate : candidates){
+            next.push_back(candidate.node);
+        }
+        levels.push_back(move(next));
+    }
+    if(!found){
+        return solution;
+    }
+
+    for(int depth = levels.size() - 1; goal.parent != -1; depth--){
+        solution.moves.push_back({goal.move / 4, Solver::directionToChar(goal.move % 4)});
+        goal = levels[depth][goal.parent];
+    }
+    reverse(solution.moves.begin(), solution.moves.end());
+    solution.solved = true;
+    return solution;
+}
@@ -0,0 +1,64 @@
+/**
+ * @file anytime.h
+ * @author Bastien
+ * @brief Class for the solver that gives its best answer before a deadline
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+#ifndef ANYTIME_H
+#define ANYTIME_H
+
+#include "bidirectional.h"
+#include "solver.h"
+#include <chrono>
+#include <functional>
+#include <stop_token>
+
+/**
+ * The number of states kept at each level by the first beam search.
+ */
+const int ANYTIME_BEAM_WIDTH = 256;
+
+/**
+ * The largest number of states kept at each level by a beam search, the width being multiplied by 4 after each iteration of the exact search.
+ */
+const int ANYTIME_MAX_BEAM_WIDTH = 1 << 16;
+
+/**
+ * The number of slots the set of states seen by a beam search starts with, a power of 2.
+ */
+const size_t ANYTIME_VISITED_CAPACITY = 1 << 16;
+
+/**
+ * @brief The AnytimeSolver class gives the best solution it can find before a deadline, with bounds on the optimal number of moves.
+ * @details A beam search first gives a solution in a few milliseconds: each level keeps the states whose robots are the closest to the target by the distance maps of the snapshot, so the solution is valid but maybe not the shortest. Its length is an upper bound. The bidirectional solver then looks for shorter solutions only, each of its forward levels raising the proven lower bound; between two levels a wider beam search may lower the upper bound. When the bounds meet, the solution is optimal. The bidirectional solver is kept with the anytime solver, so the states it searched are freed after the answer is given, and getExactSolver hands its searches over (see Evaluator).
+ * The search stops when the deadline passes or a stop is requested on the token, within a millisecond, and returns the best solution found so far. The progress callback is called from the solving thread each time a bound improves.
+ */
+class AnytimeSolver{
+    private:
+        shared_ptr<const BoardSnapshot> board;
+        shared_ptr<BidirectionalSolver> exact;
+        function<void(int, int)> progress;
+        int lowerBound;
+        int upperBound;
+
+        Solution beamSearch(State start, int targetCell, int targetRobot, int width, const stop_token& token, chrono::steady_clock::time_point deadline);
+        void report(int lower, int upper);
+
+    public:
+        AnytimeSolver(Board* b);
+        AnytimeSolver(shared_ptr<const BoardSnapshot> b);
+        void setProgress(function<void(int, int)> progress);
+        int getLowerBound() const;
+        int getUpperBound() const;
+        bool isOptimal() const;
+        shared_ptr<const BidirectionalSolver> getExactSolver() const;
+        Solution solve(Robot* robots[ROBOT_COUNT], Tile* objectiveTile, chrono::steady_clock::time_point deadline, stop_token token = stop_token());
+        Solution solve(State start, int targetCell, int targetRobot, chrono::steady_clock::time_point deadline, stop_token token = stop_token());
+};
+
+#endif // ANYTIME_H
@@ -0,0 +1,389 @@
+/**
+ * @file batch.cpp
+ * @author Bastien
+ * @brief Main file for solving rounds in bulk, without the game
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+#include "bidirectional.h"
+#include "cache.h"
+#include "external.h"
+#include "log.h"
+#include "tablebase.h"
+#include <chrono>
+#include <climits>
+#include <condition_variable>
+#include <deque>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <thread>
+
+/**
+ * The number of records read but not written yet, for each worker: the reader waits past it, so memory does not grow with the input.
+ */
+const size_t RECORDS_PER_WORKER = 16;
+
+/**
+ * The time the search of a record may take by default, in seconds, before its result is given as unknown.
+ */
+const int BATCH_SECONDS = 10;
+
+/**
+ * @brief A record of the input, numbered in the order it was read
+ */
+struct Record{
+  size_t sequence;
+  size_t lineNumber;
+  string text;
+};
+
+/**
+ * @brief The state shared by the reader, the workers and the output
+ * @details The records go from the reader to the workers through pending. A result solved before the ones of the earlier records waits in solved until they are written, so the results come out in the order of the input. The reader stops while the oldest record not written yet is too far behind it, which bounds both pending and solved: a hard record holds back the ones after it for at most the time limit of its search.
+ */
+struct Pipeline{
+  mutex lock;
+  condition_variable changed;
+  deque<Record> pending;
+  // The result lines waiting for the earlier ones, by the sequence number of their record
+  map<size_t, string> solved;
+  size_t read = 0;
+  size_t written = 0;
+  bool finished = false;
+};
+
+/**
+ * @brief A worker: its board and its solver are kept from one record to the next while the board does not change, and the backward search of the solver while the target does not change
+ */
+struct Worker{
+  unique_ptr<Board> board = make_unique<Board>();
+  string layout;
+  shared_ptr<const BoardSnapshot> snapshot;
+  unique_ptr<BidirectionalSolver> solver;
+};
+
+/**
+ * @brief The setBoard function lays out the board of a record on the board of a worker
+ * @details The board is the number of an official board, or one hexadecimal digit per cell, row by row, giving the walls of the cell (1 = top, 2 = right, 4 = bottom, 8 = left) as Tile::getWalls. The edges of the board are always walls.
+ *
+ * @param worker
+ * @param layout
+ * @return false if the board is not valid
+ */
+bool setBoard(Worker& worker, const string& layout){
+  if(layout == worker.layout){
+    return true;
+  }
+  worker.layout.clear();
+  if(layout.size() == CELL_COUNT){
+    const int dx[4] = {0, 1, 0, -1};
+    const int dy[4] = {-1, 0, 1, 0};
+    worker.board->clear();
+    for(int cell = 0; cell < CELL_COUNT; cell++){
+      size_t walls = string("0123456789abcdef").find(tolower(layout[cell]));
+      if(walls == string::npos){
+        return false;
+      }
+      int x = cell % X_SIZE;
+      int y = cell / X_SIZE;
+      for(int direction = 0; direction < 4; direction++){
+        int nx = x + dx[direction];
+        int ny = y + dy[direction];
+        if((walls >> direction & 1) && nx >= 0 && nx < X_SIZE && ny >= 0 && ny < Y_SIZE){
+          worker.board->setWall(x, y, direction, true);
+        }
+      }
+    }
+  }else{
+    int number;
+    size_t end = 0;
+    try{
+      number = stoi(layout, &end);
+    }catch(const exception&){
+      return false;
+    }
+    if(end != layout.size() || !worker.board->assembleClassicBoard(number)){
+      return false;
+    }
+  }
+  worker.layout = layout;
+  worker.snapshot = worker.board->getSnapshot();
+  worker.solver = make_unique<BidirectionalSolver>(worker.snapshot);
+  return true;
+}
+
+/**
+ * @brief The readRecord function reads a record and lays out its board on the board of a worker
+ * @details A record is the board (see setBoard), the cells of the robots, the target cell and the color of the robot that has to reach it (M for any robot), separated by spaces.
+ *
+ * @param worker
+ * @param record
+ * @param cells Set to the cells of the robots
+ * @param targetCell Set to the cell to reach
+ * @param targetRobot Set to the robot that has to reach the cell, or -1 if any robot can reach it
+ * @return false if the record cannot be read
+ */
+bool readRecord(Worker& worker, const string& record, int cells[], int& targetCell, int& targetRobot){
+  istringstream fields(record);
+  string layout;
+  char color;
+  fields >> layout;
+  for(int i = 0; i < ROBOT_COUNT; i++){
+    fields >> cells[i];
+  }
+  fields >> targetCell >> color;
+  string rest;
+  if(!fields || fields >> rest || !setBoard(worker, layout)){
+    return false;
+  }
+  targetRobot = -1;
+  for(int i = 0; i < ROBOT_COUNT; i++){
+    if(ROBOT_COLORS[i] == color){
+      targetRobot = i;
+    }
+  }
+  if((targetRobot == -1 && color != 'M') || targetCell < 0 || targetCell >= CELL_COUNT){
+    return false;
+  }
+  for(int i = 0; i < ROBOT_COUNT; i++){
+    if(cells[i] < 0 || cells[i] >= CELL_COUNT){
+      return false;
+    }
+    for(int j = 0; j < i; j++){
+      if(cells[i] == cells[j]){
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+/**
+ * @brief The solveRecord function gives the result line of a record
+ * @details The result is the number of moves of an optimal solution followed by its moves (color and direction of each), "none" if the target cannot be reached, "unknown" if the deadline passed before the search proved either, or "invalid" for a record that cannot be read (see readRecord).
+ * With a memory limit, the record is solved by the external memory solver instead, which keeps its levels on disk in EXTERNAL_DIRECTORY: a round with more positions than fit in memory is solved, however long it takes, and the deadline is ignored. A search stopped midway goes on from its last level when the record is given again. The result is "unknown" if the files of the search cannot be written.
+ *
+ * @param worker
+ * @param record
+ * @param cache The solution cache, or nullptr
+ * @param deadline The time the search of the record gives up at
+ * @param memoryLimit The number of bytes of states the external memory solver keeps in memory, or 0 to solve in memory
+ * @return string
+ */
+string solveRecord(Worker& worker, const string& record, SolutionCache* cache, chrono::steady_clock::time_point deadline, size_t memoryLimit){
+  int cells[ROBOT_COUNT];
+  int targetCell;
+  int targetRobot;
+  if(!readRecord(worker, record, cells, targetCell, targetRobot)){
+    return "invalid";
+  }
+
+  State start = Solver::packState(cells);
+  uint64_t key = SolutionCache::getKey(*worker.snapshot, start, targetCell, targetRobot);
+  Solution solution;
+  bool cached = cache != nullptr && cache->find(key, solution);
+  if(!cached && memoryLimit > 0){
+    ExternalSolver solver(worker.snapshot, EXTERNAL_DIRECTORY, memoryLimit);
+    solution = solver.solve(start, targetCell, targetRobot);
+    // The files of the search could not be written
+    if(!solver.isComplete()){
+      return "unknown";
+    }
+    if(cache != nullptr){
+      cache->insert(key, solution);
+    }
+  }else if(!cached){
+    worker.solver->setStop(stop_token(), deadline);
+    solution = worker.solver->solve(start, targetCell, targetRobot);
+    // The bidirectional solver proves the round unsolvable when its forward search runs out of states
+    if(!solution.solved && worker.solver->getLowerBound() != INT_MAX){
+      return "unknown";
+    }
+    if(cache != nullptr){
+      cache->insert(key, solution);
+    }
+  }
+  if(!solution.solved){
+    return "none";
+  }
+  string result = to_string(solution.moves.size());
+  for(const Move& move : solution.moves){
+    result += string(" ") + ROBOT_COLORS[move.robot] + move.direction;
+  }
+  return result;
+}
+
+/**
+ * @brief The work function solves the records until the input ends, writing the results that are next in the order of the input
+ * @details Each result line starts with the line number of its record, as the blank lines and the comments of the input have none.
+ *
+ * @param pipeline
+ * @param cache The solution cache, or nullptr
+ * @param seconds The time limit of each record
+ * @param memoryLimit The memory of the external memory solver, or 0 to solve in memory (see solveRecord)
+ * @param output
+ */
+void work(Pipeline& pipeline, SolutionCache* cache, int seconds, size_t memoryLimit, ostream& output){
+  Worker worker;
+  while(true){
+    Record record;
+    {
+      unique_lock<mutex> guard(pipeline.lock);
+      pipeline.changed.wait(guard, [&]{ return !pipeline.pending.empty() || pipeline.finished; });
+      if(pipeline.pending.empty()){
+        return;
+      }
+      record = move(pipeline.pending.front());
+      pipeline.pending.pop_front();
+      pipeline.changed.notify_all();
+    }
+    string result = solveRecord(worker, record.text, cache, chrono::steady_clock::now() + chrono::seconds(seconds), memoryLimit);
+    lock_guard<mutex> guard(pipeline.lock);
+    pipeline.solved[record.sequence] = to_string(record.lineNumber) + " " + result;
+    for(auto next = pipeline.solved.begin(); next != pipeline.solved.end() && next->first == pipeline.written; next = pipeline.solved.erase(next)){
+      output << next->second << endl;
+      pipeline.written++;
+    }
+    pipeline.changed.notify_all();
+  }
+}
+
+/**
+ * @brief The submit function hands a record to the workers, waiting while too many records are read but not written
+ *
+ * @param pipeline
+ * @param lineNumber
+ * @param record
+ * @param limit The largest number of records read but not written
+ */
+void submit(Pipeline& pipeline, size_t lineNumber, string& record, size_t limit){
+  unique_lock<mutex> guard(pipeline.lock);
+  pipeline.changed.wait(guard, [&]{ return pipeline.read - pipeline.written < limit; });
+  pipeline.pending.push_back({pipeline.read++, lineNumber, move(record)});
+  pipeline.changed.notify_all();
+}
+
+/**
+ * @brief The buildTablebases function builds and saves the tablebase of the target of each record, one after the other
+ * @details The robots of the records are ignored, a tablebase covering every placement. A tablebase already saved is only opened. For each record, the line number is followed by the file of the tablebase, "too large" if it has more than TABLEBASE_MAX_ENTRIES positions, or "invalid". The game and the evaluator of the demonstrations use the tablebases saved in TABLEBASE_DIRECTORY.
+ *
+ * @param input
+ * @param output
+ * @return size_t The number of records read
+ */
+size_t buildTablebases(istream& input, ostream& output){
+  Worker worker;
+  string line;
+  size_t lineNumber = 0;
+  size_t count = 0;
+  while(getline(input, line)){
+    lineNumber++;
+    size_t first = line.find_first_not_of(" \t\r");
+    if(first == string::npos || line[first] == '#'){
+      continue;
+    }
+    count++;
+    int cells[ROBOT_COUNT];
+    int targetCell;
+    int targetRobot;
+    if(!readRecord(worker, line, cells, targetCell, targetRobot)){
+      output << lineNumber << " invalid" << endl;
+      continue;
+    }
+    shared_ptr<const Tablebase> tablebase = Tablebase::get(worker.snapshot, targetCell, targetRobot);
+    if(tablebase == nullptr){
+      output << lineNumber << " too large" << endl;
+      continue;
+    }
+    output << lineNumber << " " << tablebase->getPath(TABLEBASE_DIRECTORY) << endl;
+  }
+  return count;
+}
+
+int main(int argc, char* argv[])
+{
+  setLogLevel(LogLevel::NONE);
+
+  int threads = max(1u, thread::hardware_concurrency());
+  bool useCache = true;
+  bool tablebases = false;
+  int seconds = BATCH_SECONDS;
+  size_t memoryLimit = 0;
+  string path = "-";
+  for(int i = 1; i < argc; i++){
+    string argument = argv[i];
+    if(argument == "-j" && i + 1 < argc && atoi(argv[i + 1]) > 0){
+      threads = atoi(argv[++i]);
+    }else if(argument == "-s" && i + 1 < argc && atoi(argv[i + 1]) > 0){
+      seconds = atoi(argv[++i]);
+    }else if(argument == "-e" && i + 1 < argc && atoi(argv[i + 1]) > 0){
+      memoryLimit = (size_t)atoi(argv[++i]) << 20;
+    }else if(argument == "-n"){
+      useCache = false;
+    }else if(argument == "-t"){
+      tablebases = true;
+    }else if(argument[0] != '-' || argument == "-"){
+      path = argument;
+    }else{
+      cerr << "Usage: " << argv[0] << " [-j threads] [-s seconds] [-e megabytes] [-n] [-t] [file]" << endl;
+      cerr << "Reads one round per line (board, " << ROBOT_COUNT << " robot cells, target cell, target color) from the file or the standard input and writes the optimal solution of each in the same order, after the line number of the round. A round not solved within the given seconds (" << BATCH_SECONDS << " by default) is written as unknown. -e solves each round with the external memory solver instead, keeping at most the given megabytes of positions in memory per thread and the rest on disk in the " << EXTERNAL_DIRECTORY << " directory, with no time limit: a round stopped midway goes on from its last level when it is given again. -n does not use the solution cache. -t builds and saves the tablebase of the target of each round instead." << endl;
+      return 1;
+    }
+  }
+  ifstream file;
+  if(path != "-"){
+    file.open(path);
+    if(!file){
+      cerr << "Could not open " << path << endl;
+      return 1;
+    }
+  }
+  istream& input = path == "-" ? cin : file;
+  if(tablebases){
+    size_t count = buildTablebases(input, cout);
+    cerr << count << " records read" << endl;
+    return 0;
+  }
+  unique_ptr<SolutionCache> cache = useCache ? make_unique<SolutionCache>() : nullptr;
+
+  Pipeline pipeline;
+  vector<thread> workers;
+  for(int i = 0; i < threads; i++){
+    workers.emplace_back(work, ref(pipeline), cache.get(), seconds, memoryLimit, ref(cout));
+  }
+
+  string line;
+  size_t lineNumber = 0;
+  size_t count = 0;
+  while(getline(input, line)){
+    lineNumber++;
+    size_t first = line.find_first_not_of(" \t\r");
+    if(first == string::npos || line[first] == '#'){
+      continue;
+    }
+    count++;
+    submit(pipeline, lineNumber, line, threads * RECORDS_PER_WORKER);
+  }
+  {
+    lock_guard<mutex> guard(pipeline.lock);
+    pipeline.finished = true;
+    pipeline.changed.notify_all();
+  }
+  for(thread& worker : workers){
+    worker.join();
+  }
+
+  cerr << count << " records read";
+  if(cache){
+    cerr << ", solution cache: " << cache->getHits() << " hits, " << cache->getMisses() << " misses, " << cache->getEvictions() << " evictions";
+  }
+  cerr << endl;
+  return 0;
+}
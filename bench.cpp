@@ -0,0 +1,146 @@
+/**
+ * @file bench.cpp
+ * @author Bastien
+ * @brief Main file for measuring how the parallel solver scales with the number of threads
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+#include "log.h"
+#include "parallel.h"
+#include "sample.h"
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <thread>
+
+/**
+ * The largest number of threads measured by default, whatever the number of hardware threads: the speedup asked of the parallel solver is measured up to it.
+ */
+const int BENCH_MAX_THREADS = 16;
+
+/**
+ * The number of times each thread count solves the rounds by default, the median time being kept.
+ */
+const int BENCH_RUNS = 3;
+
+/**
+ * The number of rounds drawn for each round kept, at most, when only the rounds of some number of moves are kept.
+ */
+const int BENCH_DRAWS_PER_ROUND = 100;
+
+/**
+ * @brief The solveAll function solves every round with the parallel solver
+ *
+ * @param boards The seed of the board of each round
+ * @param rounds
+ * @param threads
+ * @param moves Set to the number of moves of each solution, -1 if unsolved
+ * @param nodes Set to the number of states expanded
+ * @return double The number of seconds spent solving, the boards being laid out outside of it
+ */
+double solveAll(const vector<unsigned>& boards, const vector<SampleRound>& rounds, int threads, vector<int>& moves, long long& nodes){
+  Board board;
+  double seconds = 0;
+  moves.clear();
+  nodes = 0;
+  for(size_t i = 0; i < rounds.size(); i++){
+    mt19937 gen(boards[i]);
+    sampleBoard(&board, gen);
+    ParallelSolver solver(board.getSnapshot(), threads);
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    Solution solution = solver.solve(rounds[i].start, rounds[i].targetCell, rounds[i].targetRobot);
+    seconds += chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    moves.push_back(solution.solved ? solution.moves.size() : -1);
+    nodes += solution.nodes;
+  }
+  return seconds;
+}
+
+int main(int argc, char* argv[])
+{
+  setLogLevel(LogLevel::NONE);
+
+  int hardware = max(1u, thread::hardware_concurrency());
+  int maxThreads = BENCH_MAX_THREADS;
+  int count = 20;
+  int runs = BENCH_RUNS;
+  int minMoves = 0;
+  unsigned seed = 1;
+  for(int i = 1; i < argc; i++){
+    string argument = argv[i];
+    if(argument == "-j" && i + 1 < argc && atoi(argv[i + 1]) > 0){
+      maxThreads = atoi(argv[++i]);
+    }else if(argument == "-r" && i + 1 < argc && atoi(argv[i + 1]) > 0){
+      count = atoi(argv[++i]);
+    }else if(argument == "-n" && i + 1 < argc && atoi(argv[i + 1]) > 0){
+      runs = atoi(argv[++i]);
+    }else if(argument == "-m" && i + 1 < argc && atoi(argv[i + 1]) >= 0){
+      minMoves = atoi(argv[++i]);
+    }else if(argument == "-s" && i + 1 < argc){
+      seed = strtoul(argv[++i], nullptr, 10);
+    }else{
+      cerr << "Usage: " << argv[0] << " [-j threads] [-r rounds] [-n runs] [-m moves] [-s seed]" << endl;
+      cerr << "Solves the same rounds with the parallel solver on 1, 2, 4, 8... threads up to the given number (" << BENCH_MAX_THREADS << " by default), each thread count " << BENCH_RUNS << " times by default, and prints the median time, the speedup over 1 thread and the efficiency (speedup per thread) of each. -m only keeps the rounds of at least that many moves, so that each level has enough states to share out." << endl;
+      return 1;
+    }
+  }
+
+  // The rounds are drawn once, each with the seed of its board, so every thread count solves the same ones. An untimed pass on 1 thread gives the solutions every thread count must find, and warms up the allocator and the caches
+  mt19937 gen(seed);
+  vector<unsigned> boards;
+  vector<SampleRound> rounds;
+  vector<int> reference;
+  Board board;
+  for(int draws = 0; (int)rounds.size() < count && draws < count * BENCH_DRAWS_PER_ROUND; draws++){
+    unsigned boardSeed = gen();
+    mt19937 boardGen(boardSeed);
+    sampleBoard(&board, boardGen);
+    SampleRound round = sampleRound(&board, gen);
+    Solution solution = ParallelSolver(board.getSnapshot(), 1).solve(round.start, round.targetCell, round.targetRobot);
+    if(solution.solved && (int)solution.moves.size() < minMoves){
+      continue;
+    }
+    boards.push_back(boardSeed);
+    rounds.push_back(round);
+    reference.push_back(solution.solved ? solution.moves.size() : -1);
+  }
+
+  cout << rounds.size() << " rounds on " << X_SIZE << "x" << Y_SIZE << " with " << ROBOT_COUNT << " robots";
+  if(minMoves > 0){
+    cout << " of at least " << minMoves << " moves";
+  }
+  cout << ", seed " << seed << ", " << runs << " runs, hardware threads: " << hardware << endl;
+  if(maxThreads > hardware){
+    cout << "Past " << hardware << " threads the workers share the cores: the times show the cost of the extra threads, not how the solver scales" << endl;
+  }
+  cout << setw(8) << "threads" << setw(12) << "seconds" << setw(20) << "min-max" << setw(16) << "states/s" << setw(10) << "speedup" << setw(12) << "efficiency" << endl;
+  double base = 0;
+  for(int threads = 1; ; threads = min(threads * 2, maxThreads)){
+    vector<double> times;
+    long long nodes = 0;
+    bool same = true;
+    for(int run = 0; run < runs; run++){
+      vector<int> moves;
+      times.push_back(solveAll(boards, rounds, threads, moves, nodes));
+      same &= moves == reference;
+    }
+    sort(times.begin(), times.end());
+    double seconds = times[times.size() / 2];
+    if(threads == 1){
+      base = seconds;
+    }
+    ostringstream spread;
+    spread << fixed << setprecision(3) << times.front() << "-" << times.back();
+    cout << setw(8) << threads << setw(12) << fixed << setprecision(3) << seconds << setw(20) << spread.str() << setw(16) << setprecision(0) << nodes / seconds << setw(10) << setprecision(2) << base / seconds << setw(12) << base / seconds / threads << (same ? "" : "  different solutions") << endl;
+    if(threads == maxThreads){
+      break;
+    }
+  }
+  return 0;
+}
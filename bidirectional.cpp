@@ -0,0 +1,543 @@
+/**
+ * @file bidirectional.cpp
+ * @author Bastien
+ * @brief Class for the bidirectional solver (Implementation File)
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+#include "bidirectional.h"
+#include "log.h"
+#include <algorithm>
+#include <climits>
+
+const int STEPS[4] = {-X_SIZE, 1, X_SIZE, -1};
+
+/**
+ * @brief Construct a new BidirectionalSolver:: BidirectionalSolver object
+ *
+ * @param b The board to solve, its current snapshot is used
+ */
+BidirectionalSolver::BidirectionalSolver(Board* b) : BidirectionalSolver(b->getSnapshot()){
+}
+
+/**
+ * @brief Construct a new BidirectionalSolver:: BidirectionalSolver object
+ *
+ * @param b The snapshot of the board to solve
+ */
+BidirectionalSolver::BidirectionalSolver(shared_ptr<const BoardSnapshot> b){
+    this->board = b;
+    this->capacity = 0;
+    this->root = 0;
+    this->backwardCell = -1;
+    this->backwardRobot = -1;
+    this->backwardDepth = 0;
+    this->backwardLimit = BIDIRECTIONAL_BACKWARD_LIMIT;
+    this->helperCells.assign(CELL_COUNT + 1, bitset<CELL_COUNT>());
+    this->maxDepth = INT_MAX;
+    this->lowerBound = 0;
+    this->cancelled = false;
+    this->deadline = chrono::steady_clock::time_point::max();
+}
+
+/**
+ * @brief The setBackwardLimit function sets the number of partial states the backward search may keep
+ * @details A larger backward search takes longer to build but answers more positions on its own, which pays off when it is kept for many solves of the same target.
+ *
+ * @param limit BIDIRECTIONAL_BACKWARD_LIMIT by default
+ */
+void BidirectionalSolver::setBackwardLimit(int limit){
+    if(limit != this->backwardLimit){
+        this->backwardLimit = limit;
+        this->backwardCell = -1;
+    }
+}
+
+/**
+ * @brief The setMaxDepth function sets the largest number of moves of a solution looked for
+ * @details The search gives up once it proved that the round needs more moves. It can be lowered from the progress callback, when a solution of that many moves is already known.
+ *
+ * @param depth
+ */
+void BidirectionalSolver::setMaxDepth(int depth){
+    this->maxDepth = depth;
+}
+
+/**
+ * @brief The setStop function sets when the search has to give up
+ *
+ * @param token The search stops when a stop is requested on it
+ * @param deadline The search stops when this time is reached
+ */
+void BidirectionalSolver::setStop(stop_token token, chrono::steady_clock::time_point deadline){
+    this->stopToken = token;
+    this->deadline = deadline;
+}
+
+/**
+ * @brief The setProgress function sets the function called after each forward level without a solution
+ *
+ * @param progress Called with the new lower bound, from the thread running the search
+ */
+void BidirectionalSolver::setProgress(function<void(int)> progress){
+    this->progress = progress;
+}
+
+/**
+ * @brief The getLowerBound function returns the number of moves the last search proved the round needs at least
+ *
+ * @return The bound, or INT_MAX if the target cannot be reached
+ */
+int BidirectionalSolver::getLowerBound() const{
+    return this->lowerBound;
+}
+
+/**
+ * @brief The isCancelled function checks if the last search gave up because of the stop token or the deadline
+ *
+ * @return true
+ * @return false
+ */
+bool BidirectionalSolver::isCancelled() const{
+    return this->cancelled;
+}
+
+/**
+ * @brief The copyBackward function takes the backward search another solver ran for a target, so that the next solve of that target starts with it
+ *
+ * @param other
+ * @param targetCell The cell to reach
+ * @param targetRobot The robot that has to reach the cell, or -1 if any robot can reach it
+ * @return false if the other solver has no backward search of that target
+ */
+bool BidirectionalSolver::copyBackward(const BidirectionalSolver& other, int targetCell, int targetRobot){
+    if(other.backwardCell == -1 || other.backwardCell != targetCell || other.backwardRobot != targetRobot){
+        return false;
+    }
+    this->partials = other.partials;
+    this->index = other.index;
+    this->helperCells = other.helperCells;
+    this->capacity = other.capacity;
+    this->backwardCell = other.backwardCell;
+    this->backwardRobot = other.backwardRobot;
+    this->backwardDepth = other.backwardDepth;
+    this->backwardLimit = other.backwardLimit;
+    return true;
+}
+
+/**
+ * @brief The getForwardDepth function gives the number of moves from the start of the last solve to a state, if its forward search reached it
+ * @details The forward search is breadth-first, so the parent of each state is one move closer to the start.
+ *
+ * @param state
+ * @return The fewest moves from the start to the state, or -1 if the forward search did not reach it
+ */
+int BidirectionalSolver::getForwardDepth(State state) const{
+    State key = this->symmetry.canonical(state);
+    auto found = this->parents.find(key);
+    if(found == this->parents.end()){
+        return -1;
+    }
+    int depth = 0;
+    while(key != this->root){
+        key = found->second.first;
+        found = this->parents.find(key);
+        depth++;
+    }
+    return depth;
+}
+
+/**
+ * @brief The shouldStop function checks the stop token and the deadline
+ *
+ * @return true
+ * @return false
+ */
+bool BidirectionalSolver::shouldStop() const{
+    return this->stopToken.stop_requested() || chrono::steady_clock::now() >= this->deadline;
+}
+
+/**
+ * @brief The key function packs the cells of a partial state in an integer, 10 bits per cell
+ *
+ * @param pinned The cell of the target robot, or -1
+ * @param cells The cells of the other robots, sorted
+ * @param count The number of cells
+ * @return uint64_t
+ */
+uint64_t BidirectionalSolver::key(int pinned, const int* cells, int count){
+    uint64_t key = pinned + 1;
+    key = key * 8 + count;
+    for(int i = 0; i < count; i++){
+        key = key * 1024 + cells[i];
+    }
+    return key;
+}
+
+/**
+ * @brief The addPartial function adds a partial state to the backward search, unless a known one with the same cells asks for less
+ * @details The partial states are added level by level, so a known state is never deeper than a new one.
+ *
+ * @param state The state, its cells are sorted here
+ * @return true if the state was added
+ * @return false
+ */
+bool BidirectionalSolver::addPartial(PartialState& state){
+    sort(state.cells, state.cells + state.count);
+    vector<int>& bucket = this->index[key(state.pinned, state.cells, state.count)];
+    for(int i : bucket){
+        if((this->partials[i].empty & ~state.empty).none()){
+            return false;
+        }
+    }
+    bucket.push_back(this->partials.size());
+    this->partials.push_back(state);
+    for(int i = 0; i < state.count; i++){
+        this->helperCells[state.pinned == -1 ? CELL_COUNT : state.pinned].set(state.cells[i]);
+    }
+    return true;
+}
+
+/**
+ * @brief The regress function adds the partial states one move before a partial state
+ * @details A robot with a cell can have moved last, in any direction where something stops it: a wall, a robot with a cell, or one more robot put there. It came from a cell of the reverse path, and the cells it crossed must be free.
+ * A robot without a cell can have moved last only to leave a cell that must be free, otherwise the move could be left out of the solution: it gets the cell it left, and the cell it went to must be allowed to it.
+ *
+ * @param i The index of the partial state
+ */
+void BidirectionalSolver::regress(int i){
+    const PartialState state = this->partials[i];
+    auto isTaken = [&](int cell){
+        if(cell == state.pinned){
+            return true;
+        }
+        for(int j = 0; j < state.count; j++){
+            if(state.cells[j] == cell){
+                return true;
+            }
+        }
+        return false;
+    };
+    // Whether something stops a robot on a cell in a direction: -1 if not possible, the cell of the robot to add, or CELL_COUNT if nothing has to be added
+    auto stopper = [&](int cell, int direction, int free){
+        if(this->board->hasWall(cell, direction)){
+            return CELL_COUNT;
+        }
+        int next = cell + STEPS[direction];
+        if(isTaken(next)){
+            return CELL_COUNT;
+        }
+        if(state.empty[next] || free == 0){
+            return -1;
+        }
+        return next;
+    };
+    auto add = [&](PartialState child, int blocker, int from, int direction){
+        if(blocker != CELL_COUNT){
+            child.cells[child.count++] = blocker;
+        }
+        child.depth = state.depth + 1;
+        child.parent = i;
+        child.moveCell = from;
+        child.moveDirection = direction;
+        this->addPartial(child);
+    };
+
+    vector<int> path;
+    int free = this->capacity - state.count;
+    for(int robot = -1; robot < state.count; robot++){
+        int cell = robot == -1 ? state.pinned : state.cells[robot];
+        if(cell == -1){
+            continue;
+        }
+        for(int direction = 0; direction < 4; direction++){
+            int blocker = stopper(cell, direction, free);
+            if(blocker == -1){
+                continue;
+            }
+            this->board->getReversePath(cell, direction, path);
+            bitset<CELL_COUNT> crossed;
+            crossed.set(cell);
+            for(int from : path){
+                if(isTaken(from)){
+                    break;
+                }
+                PartialState child = state;
+                if(robot == -1){
+                    child.pinned = from;
+                }else{
+                    child.cells[robot] = from;
+                }
+                child.empty |= crossed;
+                add(child, blocker, from, direction);
+                crossed.set(from);
+            }
+        }
+    }
+
+    if(free == 0){
+        return;
+    }
+    for(int from = 0; from < CELL_COUNT; from++){
+        if(!state.empty[from] || isTaken(from)){
+            continue;
+        }
+        for(int direction = 0; direction < 4; direction++){
+            bitset<CELL_COUNT> crossed;
+            for(int cell = from; !this->board->hasWall(cell, direction);){
+                cell += STEPS[direction];
+                if(isTaken(cell)){
+                    break;
+                }
+                crossed.set(cell);
+                if(state.empty[cell]){
+                    continue;
+                }
+                int blocker = stopper(cell, direction, free - 1);
+                if(blocker == -1){
+                    continue;
+                }
+                PartialState child = state;
+                child.cells[child.count++] = from;
+                child.empty |= crossed;
+                add(child, blocker, from, direction);
+            }
+        }
+    }
+}
+
+/**
+ * @brief The match function finds the shallowest partial state a state belongs to
+ * @details The cells of a partial state are a subset of the cells of the other robots, each subset is looked up. Only the robots on a cell that some partial state of the same pinned cell uses can be in that subset, so the others are left out of the lookups.
+ *
+ * @param state A state of the forward search
+ * @param targetRobot The robot that has to reach the target, or -1 if any robot can
+ * @return The index of the partial state, or -1 if there is none
+ */
+int BidirectionalSolver::match(State state, int targetRobot) const{
+    int pinned = targetRobot == -1 ? -1 : Solver::getRobotCell(state, targetRobot);
+    const bitset<CELL_COUNT>& used = this->helperCells[pinned == -1 ? CELL_COUNT : pinned];
+    int helpers[ROBOT_COUNT];
+    int helperCount = 0;
+    int others[ROBOT_COUNT];
+    int otherCount = 0;
+    for(int i = 0; i < ROBOT_COUNT; i++){
+        if(i == targetRobot){
+            continue;
+        }
+        int cell = Solver::getRobotCell(state, i);
+        if(used[cell]){
+            helpers[helperCount++] = cell;
+        }else{
+            others[otherCount++] = cell;
+        }
+    }
+    sort(helpers, helpers + helperCount);
+
+    int best = -1;
+    int cells[ROBOT_COUNT];
+    for(int subset = 0; subset < (1 << helperCount); subset++){
+        int count = 0;
+        for(int i = 0; i < helperCount; i++){
+            if(subset & (1 << i)){
+                cells[count++] = helpers[i];
+            }
+        }
+        auto found = this->index.find(key(pinned, cells, count));
+        if(found == this->index.end()){
+            continue;
+        }
+        for(int candidate : found->second){
+            const PartialState& partial = this->partials[candidate];
+            bool free = true;
+            for(int i = 0; i < helperCount && free; i++){
+                free = (subset & (1 << i)) || !partial.empty[helpers[i]];
+            }
+            for(int i = 0; i < otherCount && free; i++){
+                free = !partial.empty[others[i]];
+            }
+            if(free && (best == -1 || partial.depth < this->partials[best].depth)){
+                best = candidate;
+            }
+        }
+    }
+    return best;
+}
+
+/**
+ * @brief The solve function solves the current round
+ * @details Same goal as Solver::solve: the robot matching the color of the objective tile has to reach it, or any robot if the objective tile is multicolored.
+ *
+ * @param robots The robots of the game
+ * @param objectiveTile The objective tile
+ * @return Solution
+ */
+Solution BidirectionalSolver::solve(Robot* robots[ROBOT_COUNT], Tile* objectiveTile){
+    int cells[ROBOT_COUNT];
+    int targetRobot = -1;
+    for(int i = 0; i < ROBOT_COUNT; i++){
+        cells[i] = robots[i]->getCell();
+        if(robots[i]->getColor() == objectiveTile->getTargetColor()){
+            targetRobot = i;
+        }
+    }
+    int targetCell = robots[0]->getBoard()->getCell(objectiveTile);
+    return this->solve(Solver::packState(cells), targetCell, targetRobot);
+}
+
+/**
+ * @brief The searchBackward function runs the backward search from a target, one full level at a time, unless it was already run for that target
+ * @details On a board with deflectors only the goal is known backwards, the forward search then does all the work.
+ *
+ * @param targetCell The cell to reach
+ * @param targetRobot The robot that has to reach the cell, or -1 if any robot can reach it
+ * @return false if it was stopped, the partial states are then dropped
+ */
+bool BidirectionalSolver::searchBackward(int targetCell, int targetRobot){
+    if(targetCell == this->backwardCell && targetRobot == this->backwardRobot){
+        return true;
+    }
+    this->backwardCell = -1;
+    this->partials.clear();
+    this->index.clear();
+    this->helperCells.assign(CELL_COUNT + 1, bitset<CELL_COUNT>());
+    PartialState goal;
+    goal.pinned = targetRobot == -1 ? -1 : targetCell;
+    goal.count = 0;
+    if(targetRobot == -1){
+        goal.cells[goal.count++] = targetCell;
+    }
+    goal.depth = 0;
+    goal.parent = -1;
+    goal.moveCell = -1;
+    goal.moveDirection = -1;
+    this->capacity = targetRobot == -1 ? ROBOT_COUNT : ROBOT_COUNT - 1;
+    this->addPartial(goal);
+    if(this->board->hasDeflectors()){
+        log(LogLevel::DEBUG, "No reverse moves with deflectors, solving forwards only");
+    }else{
+        for(size_t levelStart = 0; levelStart < this->partials.size() && this->partials.size() < this->backwardLimit;){
+            size_t levelEnd = this->partials.size();
+            for(size_t i = levelStart; i < levelEnd; i++){
+                if(i % BIDIRECTIONAL_CHECK_INTERVAL == 0 && this->shouldStop()){
+                    this->partials.clear();
+                    this->index.clear();
+                    return false;
+                }
+                this->regress(i);
+            }
+            levelStart = levelEnd;
+        }
+    }
+    this->backwardDepth = this->partials.back().depth;
+    this->backwardCell = targetCell;
+    this->backwardRobot = targetRobot;
+    return true;
+}
+
+/**
+ * @brief The solve function runs the backward search from the target, then the forward search from a start state until they meet
+ * @details The search gives up, unsolved, when it is stopped (see isCancelled) or when the round needs more moves than setMaxDepth allows; getLowerBound tells how far it got.
+ *
+ * @param start The start state
+ * @param targetCell The cell to reach
+ * @param targetRobot The robot that has to reach the cell, or -1 if any robot can reach it
+ * @return Solution
+ */
+Solution BidirectionalSolver::solve(State start, int targetCell, int targetRobot){
+    Solution solution;
+    solution.solved = false;
+    solution.nodes = 0;
+    this->cancelled = false;
+    this->lowerBound = 0;
+
+    if(!this->searchBackward(targetCell, targetRobot)){
+        this->cancelled = true;
+        log(LogLevel::DEBUG, "Bidirectional solver stopped while searching backwards");
+        return solution;
+    }
+    solution.nodes = this->partials.size();
+
+    // Forward search on canonical states, up to the first level meeting the backward search
+    this->symmetry = Symmetry(*this->board, targetRobot);
+    const Symmetry& symmetry = this->symmetry;
+    State real = start;
+    start = symmetry.canonical(start);
+    ParentMap& parents = this->parents;
+    parents.clear();
+    this->root = start;
+    parents[start] = make_pair(start, 0);
+    vector<State> frontier(1, start);
+    int meet = this->match(start, targetRobot);
+    State meetState = start;
+    // A level without a match proves that every solution has more moves than the level plus the backward depth
+    for(int depth = 0; meet == -1; depth++){
+        this->lowerBound = frontier.empty() ? INT_MAX : depth + this->backwardDepth + 1;
+        if(frontier.empty() || this->lowerBound > this->maxDepth){
+            break;
+        }
+        if(this->progress){
+            this->progress(this->lowerBound);
+            if(this->lowerBound > this->maxDepth){
+                break;
+            }
+        }
+        vector<State> next;
+        for(State state : frontier){
+            solution.nodes++;
+            if((solution.nodes & (BIDIRECTIONAL_CHECK_INTERVAL - 1)) == 0 && this->shouldStop()){
+                this->cancelled = true;
+                log(LogLevel::DEBUG, "Bidirectional solver stopped with at least " + to_string(this->lowerBound) + " moves after " + to_string(solution.nodes) + " nodes");
+                return solution;
+            }
+            for(int robot = 0; robot < ROBOT_COUNT; robot++){
+                int from = Solver::getRobotCell(state, robot);
+                for(int direction = 0; direction < 4; direction++){
+                    int to = this->board->slide(RobotState(state), robot, direction);
+                    if(to == from) continue;
+                    State child = symmetry.canonical(Solver::setRobotCell(state, robot, to));
+                    if(!parents.emplace(child, make_pair(state, (unsigned char)(robot * 4 + direction))).second) continue;
+                    next.push_back(child);
+                    int found = this->match(child, targetRobot);
+                    if(found != -1 && (meet == -1 || this->partials[found].depth < this->partials[meet].depth)){
+                        meet = found;
+                        meetState = child;
+                    }
+                }
+            }
+        }
+        frontier.swap(next);
+    }
+    if(meet == -1){
+        log(LogLevel::DEBUG, "Bidirectional solver found no solution after " + to_string(solution.nodes) + " nodes");
+        return solution;
+    }
+
+    // The forward half, for the real robots
+    for(State state = meetState; state != start; state = parents[state].first){
+        unsigned char move = parents[state].second;
+        solution.moves.push_back({move / 4, Solver::directionToChar(move % 4)});
+    }
+    reverse(solution.moves.begin(), solution.moves.end());
+    solution.moves = symmetry.mapMoves(*this->board, real, solution.moves);
+    RobotState robots(real);
+    for(const Move& move : solution.moves){
+        int direction = string("NESW").find(move.direction);
+        robots.move(move.robot, this->board->slide(robots, move.robot, direction));
+    }
+    // The backward half, the moving robot being found by its cell
+    for(int i = meet; this->partials[i].parent != -1; i = this->partials[i].parent){
+        int robot = robots.robotAt(this->partials[i].moveCell);
+        int direction = this->partials[i].moveDirection;
+        robots.move(robot, this->board->slide(robots, robot, direction));
+        solution.moves.push_back({robot, Solver::directionToChar(direction)});
+    }
+    solution.solved = true;
+    this->lowerBound = solution.moves.size();
+    log(LogLevel::DEBUG, "Bidirectional solver found a solution in " + to_string(solution.moves.size()) + " moves after " + to_string(solution.nodes) + " nodes (" + to_string(this->backwardDepth) + " moves searched backwards)");
+    return solution;
+}
@@ -0,0 +1,96 @@
+/**
+ * @file bidirectional.h
+ * @author Bastien
+ * @brief Class for the bidirectional solver
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+#ifndef BIDIRECTIONAL_H
+#define BIDIRECTIONAL_H
+
+#include "solver.h"
+#include <bitset>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <stop_token>
+#include <unordered_map>
+
+/**
+ * The number of partial states the backward search may keep, it stops at the end of the level that reaches it. Partial states are much more costly to expand than states, so the backward search is kept small: it only has to cover the last few moves.
+ */
+const int BIDIRECTIONAL_BACKWARD_LIMIT = 1 << 12;
+
+/**
+ * The number of states (or partial states) between two checks of the stop token and of the deadline, a power of 2.
+ */
+const int BIDIRECTIONAL_CHECK_INTERVAL = 1 << 6;
+
+/**
+ * @brief The BidirectionalSolver class computes the optimal solution of a round by searching forwards from the robots and backwards from the target until the two searches meet.
+ * @details The goal is not one state but every state with the right robot on the target, so the backward search works on partial states: the cells of the robots that matter to the end of the solution, and the cells that have to be free of the other robots. Going back over a move adds what the move needs (where the robot came from, what stopped it, which cells it crossed), using the reverse paths of the snapshot. A robot that has no cell yet is only moved backwards when it has to get out of a cell that must be free.
+ * The backward search runs first, level by level, until BIDIRECTIONAL_BACKWARD_LIMIT partial states. The forward search is then a breadth-first search on canonical states (see Symmetry) that stops at the first level where a state matches a partial state. Every solution ends with a suffix the backward search knows, so that level gives an optimal solution.
+ * The robots are told apart by their cells in the partial states: the helpers can be swapped, only the robot of the target is pinned. Boards with deflectors have no reverse paths and are solved forwards only.
+ * The backward search only depends on the target, so it is kept for the next solve of the same target: a position within its depth is then answered without a forward search.
+ * Each forward level without a match proves that the round needs more moves than that level plus the depth of the backward search, getLowerBound returns the best bound proven so far. Like IdaSolver, the search can be given a stop token, a deadline and a largest number of moves, and then gives up within a millisecond. The states it searched forwards are only freed by the next solve or with the solver, so that freeing them does not delay the answer; until then getForwardDepth looks them up.
+ */
+class BidirectionalSolver{
+    private:
+        struct PartialState{
+            int pinned;
+            int count;
+            int cells[ROBOT_COUNT];
+            bitset<CELL_COUNT> empty;
+            int depth;
+            int parent;
+            int moveCell;
+            int moveDirection;
+        };
+
+        shared_ptr<const BoardSnapshot> board;
+        vector<PartialState> partials;
+        unordered_map<uint64_t, vector<int>> index;
+        // The cells of the unpinned robots in the partial states, for each cell of the pinned robot (the last one when no robot is pinned)
+        vector<bitset<CELL_COUNT>> helperCells;
+        ParentMap parents;
+        Symmetry symmetry;
+        State root;
+        int capacity;
+        int backwardCell;
+        int backwardRobot;
+        int backwardDepth;
+        int backwardLimit;
+        int maxDepth;
+        int lowerBound;
+        bool cancelled;
+        stop_token stopToken;
+        chrono::steady_clock::time_point deadline;
+        function<void(int)> progress;
+
+        static uint64_t key(int pinned, const int* cells, int count);
+        bool addPartial(PartialState& state);
+        void regress(int i);
+        int match(State state, int targetRobot) const;
+        bool shouldStop() const;
+
+    public:
+        BidirectionalSolver(Board* b);
+        BidirectionalSolver(shared_ptr<const BoardSnapshot> b);
+        void setBackwardLimit(int limit);
+        void setMaxDepth(int depth);
+        void setStop(stop_token token, chrono::steady_clock::time_point deadline);
+        void setProgress(function<void(int)> progress);
+        int getLowerBound() const;
+        bool isCancelled() const;
+        bool searchBackward(int targetCell, int targetRobot);
+        bool copyBackward(const BidirectionalSolver& other, int targetCell, int targetRobot);
+        int getForwardDepth(State state) const;
+        Solution solve(Robot* robots[ROBOT_COUNT], Tile* objectiveTile);
+        Solution solve(State start, int targetCell, int targetRobot);
+};
+
+#endif // BIDIRECTIONAL_H
@@ -0,0 +1,441 @@
+/**
+ * @file bitboard.cpp
+ * @author Bastien
+ * @brief Class for the bitboard representation of a board (Implementation File)
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+#include "bitboard.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define BITBOARD_X86
+#endif
+
+/**
+ * @brief Construct a new Bits:: Bits object with no bit set
+ *
+ */
+template<int N>
+Bits<N>::Bits(){
+    for(int i = 0; i < WORDS; i++){
+        this->words[i] = 0;
+    }
+}
+
+/**
+ * @brief The test function checks if a bit is set
+ *
+ * @param bit
+ * @return true
+ * @return false
+ */
+template<int N>
+bool Bits<N>::test(int bit) const{
+    return (this->words[bit >> 6] >> (bit & 63)) & 1;
+}
+
+/**
+ * @brief The set function sets a bit
+ *
+ * @param bit
+ */
+template<int N>
+void Bits<N>::set(int bit){
+    this->words[bit >> 6] |= 1ULL << (bit & 63);
+}
+
+/**
+ * @brief The reset function clears a bit
+ *
+ * @param bit
+ */
+template<int N>
+void Bits<N>::reset(int bit){
+    this->words[bit >> 6] &= ~(1ULL << (bit & 63));
+}
+
+/**
+ * @brief The any function checks if at least one bit is set
+ *
+ * @return true
+ * @return false
+ */
+template<int N>
+bool Bits<N>::any() const{
+    uint64_t all = 0;
+    for(int i = 0; i < WORDS; i++){
+        all |= this->words[i];
+    }
+    return all != 0;
+}
+
+/**
+ * @brief The count function returns the number of bits set
+ *
+ * @return int
+ */
+template<int N>
+int Bits<N>::count() const{
+    int n = 0;
+    for(int i = 0; i < WORDS; i++){
+        n += __builtin_popcountll(this->words[i]);
+    }
+    return n;
+}
+
+/**
+ * @brief The getRange function returns up to 64 consecutive bits (a row, or a column for the transposed masks)
+ *
+ * @param start The first bit
+ * @param length The number of bits
+ * @return uint64_t
+ */
+template<int N>
+uint64_t Bits<N>::getRange(int start, int length) const{
+    int word = start >> 6;
+    int offset = start & 63;
+    uint64_t value = this->words[word] >> offset;
+    if(offset != 0 && offset + length > 64 && word + 1 < WORDS){
+        value |= this->words[word + 1] << (64 - offset);
+    }
+    return length == 64 ? value : value & ((1ULL << length) - 1);
+}
+
+/**
+ * @brief The shiftUp function moves every bit n places towards the higher bits. Bits going past N are dropped.
+ *
+ * @param n Less than 64
+ * @return Bits
+ */
+template<int N>
+Bits<N> Bits<N>::shiftUp(int n) const{
+    Bits<N> result;
+    for(int i = WORDS - 1; i >= 0; i--){
+        result.words[i] = this->words[i] << n;
+        if(i > 0 && n != 0){
+            result.words[i] |= this->words[i - 1] >> (64 - n);
+        }
+    }
+    if(N % 64 != 0){
+        result.words[WORDS - 1] &= (1ULL << (N % 64)) - 1;
+    }
+    return result;
+}
+
+/**
+ * @brief The shiftDown function moves every bit n places towards the lower bits
+ *
+ * @param n Less than 64
+ * @return Bits
+ */
+template<int N>
+Bits<N> Bits<N>::shiftDown(int n) const{
+    Bits<N> result;
+    for(int i = 0; i < WORDS; i++){
+        result.words[i] = this->words[i] >> n;
+        if(i + 1 < WORDS && n != 0){
+            result.words[i] |= this->words[i + 1] << (64 - n);
+        }
+    }
+    return result;
+}
+
+/**
+ * @brief Union of two sets
+ *
+ * @param other
+ * @return Bits
+ */
+template<int N>
+Bits<N> Bits<N>::operator|(const Bits<N>& other) const{
+    Bits<N> result;
+    for(int i = 0; i < WORDS; i++){
+        result.words[i] = this->words[i] | other.words[i];
+    }
+    return result;
+}
+
+/**
+ * @brief Intersection of two sets
+ *
+ * @param other
+ * @return Bits
+ */
+template<int N>
+Bits<N> Bits<N>::operator&(const Bits<N>& other) const{
+    Bits<N> result;
+    for(int i = 0; i < WORDS; i++){
+        result.words[i] = this->words[i] & other.words[i];
+    }
+    return result;
+}
+
+/**
+ * @brief Complement of a set
+ *
+ * @return Bits
+ */
+template<int N>
+Bits<N> Bits<N>::operator~() const{
+    Bits<N> result;
+    for(int i = 0; i < WORDS; i++){
+        result.words[i] = ~this->words[i];
+    }
+    if(N % 64 != 0){
+        result.words[WORDS - 1] &= (1ULL << (N % 64)) - 1;
+    }
+    return result;
+}
+
+#ifdef BITBOARD_X86
+/**
+ * @brief Moves every cell of a 16x16 board held in a 256-bit register one step in a direction
+ *
+ * @param v The set of cells
+ * @param direction 0 = N, 1 = E, 2 = S, 3 = W
+ * @return __m256i
+ */
+__attribute__((target("avx2"))) static inline __m256i shiftCellsAvx2(__m256i v, int direction){
+    switch(direction){
+        case 0:
+            return _mm256_alignr_epi8(_mm256_permute2x128_si256(v, v, 0x81), v, 2);
+        case 1:
+            return _mm256_slli_epi16(v, 1);
+        case 2:
+            return _mm256_alignr_epi8(v, _mm256_permute2x128_si256(v, v, 0x08), 14);
+        default:
+            return _mm256_srli_epi16(v, 1);
+    }
+}
+
+/**
+ * @brief Computes the cells reachable in one move on a 16x16 board with AVX2 registers: each row is a 16-bit lane, so a step east or west is a lane shift and a step north or south is a 2-byte shift of the whole register.
+ *
+ * @param walls The wall masks of the four directions
+ * @param robots The robots mask
+ * @return Bits256
+ */
+__attribute__((target("avx2"))) static Bits256 reachableAvx2(const Bits256 walls[4], const Bits256& robots){
+    __m256i occupied = _mm256_loadu_si256((const __m256i*)robots.words);
+    __m256i reachable = _mm256_setzero_si256();
+    for(int direction = 0; direction < 4; direction++){
+        __m256i wall = _mm256_loadu_si256((const __m256i*)walls[direction].words);
+        __m256i blocked = _mm256_or_si256(wall, shiftCellsAvx2(occupied, (direction + 2) % 4));
+        __m256i current = occupied;
+        for(int step = 0; step < 15; step++){
+            __m256i moving = _mm256_andnot_si256(blocked, current);
+            if(_mm256_testz_si256(moving, moving)) break;
+            current = _mm256_or_si256(_mm256_andnot_si256(moving, current), shiftCellsAvx2(moving, direction));
+        }
+        reachable = _mm256_or_si256(reachable, current);
+    }
+    Bits256 result;
+    _mm256_storeu_si256((__m256i*)result.words, _mm256_andnot_si256(occupied, reachable));
+    return result;
+}
+#endif
+
+/**
+ * @brief Construct a new BasicBitBoard:: BasicBitBoard object
+ * @details The board starts with the walls of its edges only and without robots.
+ *
+ */
+template<int W, int H>
+BasicBitBoard<W, H>::BasicBitBoard(){
+    for(int y = 0; y < H; y++){
+        this->firstColumn.set(y * W);
+        this->lastColumn.set(y * W + W - 1);
+    }
+    this->clear();
+}
+
+/**
+ * @brief The clear method removes all the walls and robots, except the walls of the edges of the board
+ *
+ */
+template<int W, int H>
+void BasicBitBoard<W, H>::clear(){
+    for(int direction = 0; direction < 4; direction++){
+        this->walls[direction] = Bits<W * H>();
+        this->transposedWalls[direction] = Bits<W * H>();
+    }
+    this->robots = Bits<W * H>();
+    this->transposedRobots = Bits<W * H>();
+    for(int x = 0; x < W; x++){
+        this->setWall(x, 0, 0, true);
+        this->setWall(x, H - 1, 2, true);
+    }
+    for(int y = 0; y < H; y++){
+        this->setWall(W - 1, y, 1, true);
+        this->setWall(0, y, 3, true);
+    }
+}
+
+/**
+ * @brief The setWall method sets or removes the wall on one side of a cell
+ *
+ * @param x
+ * @param y
+ * @param direction 0 = N, 1 = E, 2 = S, 3 = W
+ * @param wall
+ */
+template<int W, int H>
+void BasicBitBoard<W, H>::setWall(int x, int y, int direction, bool wall){
+    if(wall){
+        this->walls[direction].set(y * W + x);
+        this->transposedWalls[direction].set(x * H + y);
+    }else{
+        this->walls[direction].reset(y * W + x);
+        this->transposedWalls[direction].reset(x * H + y);
+    }
+}
+
+/**
+ * @brief The hasWall method checks if a cell has a wall on one side
+ *
+ * @param x
+ * @param y
+ * @param direction 0 = N, 1 = E, 2 = S, 3 = W
+ * @return true
+ * @return false
+ */
+template<int W, int H>
+bool BasicBitBoard<W, H>::hasWall(int x, int y, int direction) const{
+    return this->walls[direction].test(y * W + x);
+}
+
+/**
+ * @brief The setRobot method marks or unmarks a cell as occupied by a robot
+ *
+ * @param x
+ * @param y
+ * @param robot
+ */
+template<int W, int H>
+void BasicBitBoard<W, H>::setRobot(int x, int y, bool robot){
+    if(robot){
+        this->robots.set(y * W + x);
+        this->transposedRobots.set(x * H + y);
+    }else{
+        this->robots.reset(y * W + x);
+        this->transposedRobots.reset(x * H + y);
+    }
+}
+
+/**
+ * @brief The hasRobot method checks if a cell is occupied by a robot
+ *
+ * @param x
+ * @param y
+ * @return true
+ * @return false
+ */
+template<int W, int H>
+bool BasicBitBoard<W, H>::hasRobot(int x, int y) const{
+    return this->robots.test(y * W + x);
+}
+
+/**
+ * @brief The getRobots method returns the mask of the cells occupied by robots
+ *
+ * @return Bits
+ */
+template<int W, int H>
+Bits<W * H> BasicBitBoard<W, H>::getRobots() const{
+    return this->robots;
+}
+
+/**
+ * @brief The slide method computes where a robot moving from a cell stops
+ * @details The row (or column) of the move is read as a lane of the walls on the side of the move, merged with the robots shifted one cell back. The stop is the first set bit from the robot in the direction of the move.
+ *
+ * @param x
+ * @param y
+ * @param direction 0 = N, 1 = E, 2 = S, 3 = W
+ * @return The cell (y * W + x) where the robot stops
+ */
+template<int W, int H>
+int BasicBitBoard<W, H>::slide(int x, int y, int direction) const{
+    uint64_t lane;
+    switch(direction){
+        case 0:
+            lane = this->transposedWalls[0].getRange(x * H, H) | (this->transposedRobots.getRange(x * H, H) << 1);
+            lane &= (2ULL << y) - 1;
+            return (63 - __builtin_clzll(lane)) * W + x;
+        case 1:
+            lane = this->walls[1].getRange(y * W, W) | (this->robots.getRange(y * W, W) >> 1);
+            lane &= ~0ULL << x;
+            return y * W + __builtin_ctzll(lane);
+        case 2:
+            lane = this->transposedWalls[2].getRange(x * H, H) | (this->transposedRobots.getRange(x * H, H) >> 1);
+            lane &= ~0ULL << y;
+            return __builtin_ctzll(lane) * W + x;
+        default:
+            lane = this->walls[3].getRange(y * W, W) | (this->robots.getRange(y * W, W) << 1);
+            lane &= (2ULL << x) - 1;
+            return y * W + (63 - __builtin_clzll(lane));
+    }
+}
+
+/**
+ * @brief Moves every cell of a set one step in a direction. Cells leaving the board are dropped.
+ *
+ * @param b The set of cells
+ * @param direction 0 = N, 1 = E, 2 = S, 3 = W
+ * @return Bits
+ */
+template<int W, int H>
+Bits<W * H> BasicBitBoard<W, H>::shiftCells(const Bits<W * H>& b, int direction) const{
+    switch(direction){
+        case 0:
+            return b.shiftDown(W);
+        case 1:
+            return (b & ~this->lastColumn).shiftUp(1);
+        case 2:
+            return b.shiftUp(W);
+        default:
+            return (b & ~this->firstColumn).shiftDown(1);
+    }
+}
+
+/**
+ * @brief The getReachableCells method returns all the cells that any robot can reach in one move
+ * @details All the robots slide together in each direction by shifting whole masks, so the query costs a few dozen mask operations instead of one tile walk per robot. On a 16x16 board the AVX2 version is used when the processor supports it.
+ *
+ * @return Bits
+ */
+template<int W, int H>
+Bits<W * H> BasicBitBoard<W, H>::getReachableCells() const{
+#ifdef BITBOARD_X86
+    if constexpr(W == 16 && H == 16){
+        if(__builtin_cpu_supports("avx2")){
+            return reachableAvx2(this->walls, this->robots);
+        }
+    }
+#endif
+    Bits<W * H> reachable;
+    for(int direction = 0; direction < 4; direction++){
+        // A robot cannot leave a cell with a wall on that side, or a cell whose neighbour holds a robot
+        Bits<W * H> blocked = this->walls[direction] | this->shiftCells(this->robots, (direction + 2) % 4);
+        Bits<W * H> current = this->robots;
+        for(int step = 0; step < W + H; step++){
+            Bits<W * H> moving = current & ~blocked;
+            if(!moving.any()) break;
+            current = (current & ~moving) | this->shiftCells(moving, direction);
+        }
+        reachable = reachable | current;
+    }
+    return reachable & ~this->robots;
+}
+
+template struct Bits<16 * 16>;
+template struct Bits<24 * 24>;
+template struct Bits<32 * 32>;
+template class BasicBitBoard<16, 16>;
+template class BasicBitBoard<24, 24>;
+template class BasicBitBoard<32, 32>;
@@ -0,0 +1,74 @@
+/**
+ * @file bitboard.h
+ * @author Bastien
+ * @brief Class for the bitboard representation of a board
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+#ifndef BITBOARD_H
+#define BITBOARD_H
+
+#include <cstdint>
+
+/**
+ * @brief A set of N cells stored as 64-bit words.
+ * @details The bit of a cell is y * W + x, so each row of the board is a lane of W consecutive bits. A 16x16 board is a single 256-bit (AVX2) register.
+ */
+template<int N>
+struct Bits{
+    static const int WORDS = (N + 63) / 64;
+    uint64_t words[WORDS];
+
+    Bits();
+    bool test(int bit) const;
+    void set(int bit);
+    void reset(int bit);
+    bool any() const;
+    int count() const;
+    uint64_t getRange(int start, int length) const;
+    Bits shiftUp(int n) const;
+    Bits shiftDown(int n) const;
+    Bits operator|(const Bits& other) const;
+    Bits operator&(const Bits& other) const;
+    Bits operator~() const;
+};
+
+typedef Bits<256> Bits256;
+
+/**
+ * @brief The BasicBitBoard class is a second representation of a W x H board, made of bit masks.
+ * @details For each direction (0 = N, 1 = E, 2 = S, 3 = W) a mask holds the cells with a wall on that side, and another mask holds the cells occupied by robots.
+ * The masks are also kept transposed (bit x * H + y) so that columns are lanes too. A slide is then a bit scan on one lane and the cells reachable by all robots are computed with shifts of whole masks.
+ * Boards up to 32x32 are supported. The 16x16 board uses an AVX2 kernel when the processor supports it.
+ */
+template<int W, int H>
+class BasicBitBoard{
+    private:
+        Bits<W * H> walls[4];
+        Bits<W * H> transposedWalls[4];
+        Bits<W * H> robots;
+        Bits<W * H> transposedRobots;
+        Bits<W * H> firstColumn;
+        Bits<W * H> lastColumn;
+
+        Bits<W * H> shiftCells(const Bits<W * H>& b, int direction) const;
+
+    public:
+        BasicBitBoard();
+        void clear();
+        void setWall(int x, int y, int direction, bool wall);
+        bool hasWall(int x, int y, int direction) const;
+        void setRobot(int x, int y, bool robot);
+        bool hasRobot(int x, int y) const;
+        Bits<W * H> getRobots() const;
+        int slide(int x, int y, int direction) const;
+        Bits<W * H> getReachableCells() const;
+};
+
+typedef BasicBitBoard<16, 16> BitBoard;
+
+#endif // BITBOARD_H
@@ -11,6 +11,8 @@
 
 #include "board.h"
 #include "log.h"
+#include "quadrants.h"
+#include "snapshot.h"
 #include "tools.h"
 
 const string red("\033[1;41m");
@@ -25,27 +27,37 @@ const string reset("\033[0m");
  * @brief Construct a new Board:: Board object
  * 
  */
-Board::Board(){
-    for(int i = 0; i < X_SIZE; i++){
-        for(int j = 0; j < Y_SIZE; j++){
-            this->tiles[i][j] = new Tile();
-            this->tiles[i][j]->setX(i);
-            this->tiles[i][j]->setY(j);
-        }
+template<int W, int H, int R>
+BasicBoard<W, H, R>::BasicBoard(){
+    for(int i = 0; i < R; i++){
+        this->robotCells[i] = -1;
+        this->robotColors[i] = ' ';
     }
+    this->trajectoriesStale = false;
+    this->revision = 0;
+    this->clear();
 }
 
 /**
  * @brief Construct a new Board:: Board object
  * 
- * @param t a 2D array of Tile pointers 
+ * @param t a 2D array of Tile pointers, the tiles are copied in the board
  */
-Board::Board(Tile* t[X_SIZE][Y_SIZE]){
-    for(int i = 0; i < X_SIZE; i++){
-        for(int j = 0; j < Y_SIZE; j++){
-            this->tiles[i][j] = t[i][j];
+template<int W, int H, int R>
+BasicBoard<W, H, R>::BasicBoard(Tile* t[W][H]){
+    for(int i = 0; i < W; i++){
+        for(int j = 0; j < H; j++){
+            this->setTile(i, j, t[i][j]);
         }
     }
+    for(int i = 0; i < R; i++){
+        this->robotCells[i] = -1;
+        this->robotColors[i] = ' ';
+    }
+    this->trajectoriesStale = false;
+    this->revision = 0;
+    this->computeStops();
+    this->buildBitBoard();
 }
 
 /**
@@ -55,8 +67,21 @@ Board::Board(Tile* t[X_SIZE][Y_SIZE]){
  * @param y Y coordinate
  * @return Tile* 
  */
-Tile* Board::getTile(int x, int y){
-    return this->tiles[x][y];
+template<int W, int H, int R>
+Tile* BasicBoard<W, H, R>::getTile(int x, int y){
+    return &this->tiles[y * W + x];
+}
+
+/**
+ * @brief The getCell method returns the cell of a tile of the board
+ * @details The tiles are stored row by row, so the position of a tile is its index: x = cell % W and y = cell / W.
+ * 
+ * @param tile A tile of this board
+ * @return int 
+ */
+template<int W, int H, int R>
+int BasicBoard<W, H, R>::getCell(Tile* tile){
+    return tile - this->tiles;
 }
 
 /**
@@ -65,44 +90,154 @@ Tile* Board::getTile(int x, int y){
  * @param i 
  * @return Tile* 
  */
-Tile* Board::getTarget(int i){
-    return this->targets[i];
+template<int W, int H, int R>
+Tile* BasicBoard<W, H, R>::getTarget(int i){
+    return &this->tiles[this->targets[i]];
 }
 
 /**
- * @brief The setTile method sets the tile at the given position
+ * @brief The setTile method copies a tile at the given position
  * 
  * @param x X coordinate 
  * @param y Y coordinate
  * @param t Tile pointer
  */
-void Board::setTile(int x, int y, Tile* t){
-    this->tiles[x][y] = t;
+template<int W, int H, int R>
+void BasicBoard<W, H, R>::setTile(int x, int y, Tile* t){
+    this->tiles[y * W + x] = *t;
+}
+
+/**
+ * @brief The clear method empties the board in place: no walls, no targets and no robots.
+ * @details The tiles, the target list and the tables are reused, so a new board can be generated again and again without allocating.
+ */
+template<int W, int H, int R>
+void BasicBoard<W, H, R>::clear(){
+    for(int x = 0; x < W; x++){
+        for(int y = 0; y < H; y++){
+            this->tiles[y * W + x] = Tile();
+        }
+    }
+    this->targets.clear();
+    this->removeRobots();
+    this->computeStops();
+    this->buildBitBoard();
 }
 
 /**
  * @brief the initializeBoard method will do the following:
+ * - Clear the previous board, if any
  * - Place the walls
  * - Place the targets  
  * - Give debug information about the board
  */
-void Board::initializeBoard(){
+template<int W, int H, int R>
+void BasicBoard<W, H, R>::initializeBoard(){
+    this->clear();
     this->placeWalls();
     this->placeTargets();
+    this->computeStops();
+    this->buildBitBoard();
     // Print each tile's wall as log
-    for(int x = 0; x < X_SIZE; x++){
-        for(int y = 0; y < Y_SIZE; y++){
+    for(int x = 0; x < W; x++){
+        for(int y = 0; y < H; y++){
             //Print the tile's position and its walls
-            char top = this->tiles[x][y]->checkHasTopWall() ? 'T' : '*';
-            char right = this->tiles[x][y]->checkHasRightWall() ? 'R' : '*';
-            char bottom = this->tiles[x][y]->checkHasBottomWall() ? 'B' : '*';
-            char left = this->tiles[x][y]->checkHasLeftWall() ? 'L' : '*';
+            char top = this->getTile(x, y)->checkHasTopWall() ? 'T' : '*';
+            char right = this->getTile(x, y)->checkHasRightWall() ? 'R' : '*';
+            char bottom = this->getTile(x, y)->checkHasBottomWall() ? 'B' : '*';
+            char left = this->getTile(x, y)->checkHasLeftWall() ? 'L' : '*';
             log(LogLevel::DEBUG, "Tile " + to_string(x) + "," + to_string(y) + " : " + top + right + bottom + left);
         }
     }
     log(LogLevel::INFO, "Board initialized");
 }
 
+/**
+ * @brief The assembleClassicBoard method lays out one of the official boards of the original game.
+ * @details The board is made of the 4 printed quarters, in the order and on the sides given by the layout number. The quarters are read from the compile-time QUADRANTS table, already turned for their place, so the tiles are copied in 4 blocks without placing any wall or target by hand; the same layout number always gives the same board.
+ * The layout number is split as follows: layout / 16 is the order of the quarters 2, 3 and 4 on the top right, bottom right and bottom left places (the first quarter is always on the top left), and bit i of layout % 16 tells which side of quarter i + 1 is used.
+ * 
+ * @param layout The number of the board, from 0 to CLASSIC_BOARD_COUNT - 1
+ * @return true if the board was assembled
+ * @return false if the layout does not exist or the board is not 16x16
+ */
+template<int W, int H, int R>
+bool BasicBoard<W, H, R>::assembleClassicBoard(int layout){
+    if(W != 2 * QUADRANT_SIZE || H != 2 * QUADRANT_SIZE){
+        log(LogLevel::ERROR, "The official boards are only available on a 16x16 board");
+        return false;
+    }
+    if(layout < 0 || layout >= CLASSIC_BOARD_COUNT){
+        log(LogLevel::ERROR, "Official board " + to_string(layout) + " does not exist");
+        return false;
+    }
+    // Pick the quarter of each place among the remaining ones
+    const int offsetX[4] = {0, QUADRANT_SIZE, QUADRANT_SIZE, 0};
+    const int offsetY[4] = {0, 0, QUADRANT_SIZE, QUADRANT_SIZE};
+    const int factorials[3] = {2, 1, 1};
+    int order[4] = {0, 0, 0, 0};
+    int remaining[3] = {1, 2, 3};
+    int count = 3;
+    int rank = layout / 16;
+    for(int place = 1; place < 4; place++){
+        int i = rank / factorials[place - 1];
+        rank %= factorials[place - 1];
+        order[place] = remaining[i];
+        for(int j = i; j < count - 1; j++){
+            remaining[j] = remaining[j + 1];
+        }
+        count--;
+    }
+
+    this->removeRobots();
+    this->targets.clear();
+    for(int place = 0; place < 4; place++){
+        int piece = order[place];
+        const QuadrantCell* block = QUADRANTS.cells[piece][(layout >> piece) & 1][place];
+        for(int y = 0; y < QUADRANT_SIZE; y++){
+            for(int x = 0; x < QUADRANT_SIZE; x++){
+                const QuadrantCell& cell = block[y * QUADRANT_SIZE + x];
+                int boardX = offsetX[place] + x;
+                int boardY = offsetY[place] + y;
+                bool hasTarget = cell.color != ' ';
+                this->tiles[boardY * W + boardX] = Tile(cell.walls & 1, cell.walls & 4, cell.walls & 8, cell.walls & 2, hasTarget, hasTarget, cell.color == 'M', cell.central, cell.color, cell.symbol);
+            }
+        }
+    }
+    // The walls along the seams between two quarters are printed on one side only
+    for(int i = 0; i < W; i++){
+        Tile* left = this->getTile(QUADRANT_SIZE - 1, i);
+        Tile* right = this->getTile(QUADRANT_SIZE, i);
+        bool vertical = left->checkHasRightWall() || right->checkHasLeftWall();
+        left->setRightWall(vertical);
+        right->setLeftWall(vertical);
+        Tile* top = this->getTile(i, QUADRANT_SIZE - 1);
+        Tile* bottom = this->getTile(i, QUADRANT_SIZE);
+        bool horizontal = top->checkHasBottomWall() || bottom->checkHasTopWall();
+        top->setBottomWall(horizontal);
+        bottom->setTopWall(horizontal);
+    }
+    for(int cell = 0; cell < W * H; cell++){
+        if(this->tiles[cell].checkHasTarget()){
+            this->targets.push_back(cell);
+        }
+    }
+    this->computeStops();
+    this->buildBitBoard();
+    log(LogLevel::INFO, "Official board " + to_string(layout) + " assembled");
+    return true;
+}
+
+/**
+ * @brief The getTargetCount method returns the number of targets on the board
+ * 
+ * @return int 
+ */
+template<int W, int H, int R>
+int BasicBoard<W, H, R>::getTargetCount(){
+    return this->targets.size();
+}
+
 /**
  * @brief The placeWalls method will do the following:
  * - Place the board walls
@@ -112,124 +247,128 @@ void Board::initializeBoard(){
  * - Randomly place the last corner on the board according to the rules of the game.
  * 
  */
-void Board::placeWalls() {
+template<int W, int H, int R>
+void BasicBoard<W, H, R>::placeWalls() {
     random_device rd;
     mt19937 gen(rd());
+    const int HX = W / 2;
+    const int HY = H / 2;
 
     // Place the board walls
-    for (int x = 0; x < X_SIZE; x++) {
-        for (int y = 0; y < Y_SIZE; y++) {
+    for (int x = 0; x < W; x++) {
+        for (int y = 0; y < H; y++) {
             // If the tile is on the left edge of the board
             if (x == 0) {
-                this->tiles[x][y]->setLeftWall(true);
+                this->getTile(x, y)->setLeftWall(true);
             }
             // If the tile is on the right edge of the board
-            if (x == X_SIZE - 1) {
-                this->tiles[x][y]->setRightWall(true);
+            if (x == W - 1) {
+                this->getTile(x, y)->setRightWall(true);
             }
             // If the tile is on the top edge of the board
             if (y == 0) {
-                this->tiles[x][y]->setTopWall(true);
+                this->getTile(x, y)->setTopWall(true);
             }
             // If the tile is on the bottom edge of the board
-            if (y == Y_SIZE - 1) {
-                this->tiles[x][y]->setBottomWall(true);
+            if (y == H - 1) {
+                this->getTile(x, y)->setBottomWall(true);
             }
 
             // Place the central square walls
-            if (x == 7 && y == 7) {
-                this->tiles[x][y]->setTopWall(true);
-                this->tiles[x][y]->setLeftWall(true);
-                this->tiles[x - 1][y]->setRightWall(true);
-                this->tiles[x][y - 1]->setBottomWall(true);
+            if (x == HX - 1 && y == HY - 1) {
+                this->getTile(x, y)->setTopWall(true);
+                this->getTile(x, y)->setLeftWall(true);
+                this->getTile(x - 1, y)->setRightWall(true);
+                this->getTile(x, y - 1)->setBottomWall(true);
             }
-            if (x == 7 && y == 8) {
-                this->tiles[x][y]->setBottomWall(true);
-                this->tiles[x][y]->setLeftWall(true);
-                this->tiles[x - 1][y]->setRightWall(true);
-                this->tiles[x][y + 1]->setTopWall(true);
+            if (x == HX - 1 && y == HY) {
+                this->getTile(x, y)->setBottomWall(true);
+                this->getTile(x, y)->setLeftWall(true);
+                this->getTile(x - 1, y)->setRightWall(true);
+                this->getTile(x, y + 1)->setTopWall(true);
             }
-            if (x == 8 && y == 7) {
-                this->tiles[x][y]->setTopWall(true);
-                this->tiles[x][y]->setRightWall(true);
-                this->tiles[x + 1][y]->setLeftWall(true);
-                this->tiles[x][y - 1]->setBottomWall(true);
+            if (x == HX && y == HY - 1) {
+                this->getTile(x, y)->setTopWall(true);
+                this->getTile(x, y)->setRightWall(true);
+                this->getTile(x + 1, y)->setLeftWall(true);
+                this->getTile(x, y - 1)->setBottomWall(true);
             }
-            if (x == 8 && y == 8) {
-                this->tiles[x][y]->setBottomWall(true);
-                this->tiles[x][y]->setRightWall(true);
-                this->tiles[x + 1][y]->setLeftWall(true);
-                this->tiles[x][y + 1]->setTopWall(true);
+            if (x == HX && y == HY) {
+                this->getTile(x, y)->setBottomWall(true);
+                this->getTile(x, y)->setRightWall(true);
+                this->getTile(x + 1, y)->setLeftWall(true);
+                this->getTile(x, y + 1)->setTopWall(true);
             }
         }
     }
 
     // Randomly place the outer walls on the board according to the rules of the game.
-    uniform_int_distribution<int> dist(0, 7);
+    uniform_int_distribution<int> distX(0, HX - 1);
+    uniform_int_distribution<int> distY(0, HY - 1);
 
     // First quarter
-    int verticalWallQ1 = dist(gen);
-    this->tiles[verticalWallQ1][0]->setRightWall(true);
-    this->tiles[verticalWallQ1 + 1][0]->setLeftWall(true);
-    int horizontalWallQ1 = dist(gen);
+    int verticalWallQ1 = distX(gen);
+    this->getTile(verticalWallQ1, 0)->setRightWall(true);
+    this->getTile(verticalWallQ1 + 1, 0)->setLeftWall(true);
+    int horizontalWallQ1 = distY(gen);
     if (verticalWallQ1 == 0) {
         while (horizontalWallQ1 == 0) {
-            horizontalWallQ1 = dist(gen);
+            horizontalWallQ1 = distY(gen);
         }
     }
-    this->tiles[0][horizontalWallQ1]->setBottomWall(true);
-    this->tiles[0][horizontalWallQ1 + 1]->setTopWall(true);
+    this->getTile(0, horizontalWallQ1)->setBottomWall(true);
+    this->getTile(0, horizontalWallQ1 + 1)->setTopWall(true);
 
     // Second quarter
-    int verticalWallQ2 = dist(gen) + 8;
-    while (verticalWallQ2 == verticalWallQ1 + 8) {
-        verticalWallQ2 = dist(gen) + 8;
-    }
-    this->tiles[verticalWallQ2][0]->setLeftWall(true);
-    this->tiles[verticalWallQ2 - 1][0]->setRightWall(true);
-    int horizontalWallQ2 = dist(gen);
-    if (verticalWallQ2 == 15) {
+    int verticalWallQ2 = distX(gen) + HX;
+    while (verticalWallQ2 == verticalWallQ1 + HX) {
+        verticalWallQ2 = distX(gen) + HX;
+    }
+    this->getTile(verticalWallQ2, 0)->setLeftWall(true);
+    this->getTile(verticalWallQ2 - 1, 0)->setRightWall(true);
+    int horizontalWallQ2 = distY(gen);
+    if (verticalWallQ2 == W - 1) {
         while (horizontalWallQ2 == 0) {
-            horizontalWallQ2 = dist(gen);
+            horizontalWallQ2 = distY(gen);
         }
     }
-    this->tiles[15][horizontalWallQ2]->setBottomWall(true);
-    this->tiles[15][horizontalWallQ2 + 1]->setTopWall(true);
+    this->getTile(W - 1, horizontalWallQ2)->setBottomWall(true);
+    this->getTile(W - 1, horizontalWallQ2 + 1)->setTopWall(true);
 
     // Third quarter
-    int verticalWallQ3 = dist(gen);
-    this->tiles[verticalWallQ3][15]->setRightWall(true);
-    this->tiles[verticalWallQ3 + 1][15]->setLeftWall(true);
-    int horizontalWallQ3 = dist(gen) + 8;
-    while (horizontalWallQ3 == horizontalWallQ1 + 8) {
-        horizontalWallQ3 = dist(gen) + 8;
+    int verticalWallQ3 = distX(gen);
+    this->getTile(verticalWallQ3, H - 1)->setRightWall(true);
+    this->getTile(verticalWallQ3 + 1, H - 1)->setLeftWall(true);
+    int horizontalWallQ3 = distY(gen) + HY;
+    while (horizontalWallQ3 == horizontalWallQ1 + HY) {
+        horizontalWallQ3 = distY(gen) + HY;
     }
     if (verticalWallQ3 == 0) {
-        while (horizontalWallQ3 == 15) {
-            horizontalWallQ3 = dist(gen) + 8;
+        while (horizontalWallQ3 == H - 1) {
+            horizontalWallQ3 = distY(gen) + HY;
         }
     }
-    this->tiles[0][horizontalWallQ3]->setTopWall(true);
-    this->tiles[0][horizontalWallQ3 - 1]->setBottomWall(true);
+    this->getTile(0, horizontalWallQ3)->setTopWall(true);
+    this->getTile(0, horizontalWallQ3 - 1)->setBottomWall(true);
 
     // Fourth quarter
-    int verticalWallQ4 = dist(gen) + 8;
-    while (verticalWallQ4 == verticalWallQ3 + 8) {
-        verticalWallQ4 = dist(gen) + 8;
+    int verticalWallQ4 = distX(gen) + HX;
+    while (verticalWallQ4 == verticalWallQ3 + HX) {
+        verticalWallQ4 = distX(gen) + HX;
     }
-    this->tiles[verticalWallQ4][15]->setLeftWall(true);
-    this->tiles[verticalWallQ4 - 1][15]->setRightWall(true);
-    int horizontalWallQ4 = dist(gen) + 8;
-    while (horizontalWallQ4 == horizontalWallQ2 + 8) {
-        horizontalWallQ4 = dist(gen) + 8;
+    this->getTile(verticalWallQ4, H - 1)->setLeftWall(true);
+    this->getTile(verticalWallQ4 - 1, H - 1)->setRightWall(true);
+    int horizontalWallQ4 = distY(gen) + HY;
+    while (horizontalWallQ4 == horizontalWallQ2 + HY) {
+        horizontalWallQ4 = distY(gen) + HY;
     }
-    if (verticalWallQ4 == 15) {
-        while (horizontalWallQ4 == 15) {
-            horizontalWallQ4 = dist(gen) + 8;
+    if (verticalWallQ4 == W - 1) {
+        while (horizontalWallQ4 == H - 1) {
+            horizontalWallQ4 = distY(gen) + HY;
         }
     }
-    this->tiles[15][horizontalWallQ4]->setTopWall(true);
-    this->tiles[15][horizontalWallQ4 - 1]->setBottomWall(true);
+    this->getTile(W - 1, horizontalWallQ4)->setTopWall(true);
+    this->getTile(W - 1, horizontalWallQ4 - 1)->setBottomWall(true);
 
     // Place the corners on each quarter
     for (int quarter = 1; quarter < 5; quarter++) {
@@ -250,24 +389,27 @@ void Board::placeWalls() {
  * @param quarter The quarter of the board. 
  * @param corner The corner to place.
  */
-void Board::placeCorner(int quarter, int corner) {
+template<int W, int H, int R>
+void BasicBoard<W, H, R>::placeCorner(int quarter, int corner) {
+    const int HX = W / 2;
+    const int HY = H / 2;
     int minX, maxX, minY, maxY;
     switch (quarter) {
         case 1:
             // First quarter
-            minX = 1; maxX = 7; minY = 1; maxY = 7;
+            minX = 1; maxX = HX - 1; minY = 1; maxY = HY - 1;
             break;
         case 2:
             // Second quarter
-            minX = 8; maxX = 14; minY = 1; maxY = 7;
+            minX = HX; maxX = W - 2; minY = 1; maxY = HY - 1;
             break;
         case 3:
             // Third quarter
-            minX = 1; maxX = 7; minY = 8; maxY = 14;
+            minX = 1; maxX = HX - 1; minY = HY; maxY = H - 2;
             break;
         case 4:
             // Fourth quarter
-            minX = 8; maxX = 14; minY = 8; maxY = 14;
+            minX = HX; maxX = W - 2; minY = HY; maxY = H - 2;
             break;
         default:
             log(LogLevel::ERROR, "quarter " + to_string(quarter) + " does not exist.");
@@ -284,10 +426,10 @@ void Board::placeCorner(int quarter, int corner) {
     int cornerY = yDist(gen);
 
     // Check that there is no wall on that tile and that it is not adjacent to the center
-    while (this->tiles[cornerX][cornerY]->checkHasWall() ||
-           (cornerX >= 6 && cornerX <= 9) && (cornerY >= 6 && cornerY <= 9) &&
-           !(cornerX == 6 && cornerY == 6) && !(cornerX == 9 && cornerY == 6) &&
-           !(cornerX == 6 && cornerY == 9) && !(cornerX == 9 && cornerY == 9)) {
+    while (this->getTile(cornerX, cornerY)->checkHasWall() ||
+           (cornerX >= HX - 2 && cornerX <= HX + 1) && (cornerY >= HY - 2 && cornerY <= HY + 1) &&
+           !(cornerX == HX - 2 && cornerY == HY - 2) && !(cornerX == HX + 1 && cornerY == HY - 2) &&
+           !(cornerX == HX - 2 && cornerY == HY + 1) && !(cornerX == HX + 1 && cornerY == HY + 1)) {
         cornerX = xDist(gen);
         cornerY = yDist(gen);
     }
@@ -318,40 +460,40 @@ void Board::placeCorner(int quarter, int corner) {
     bool isValid = true;
 
     // Check diagonal tiles adjacent to the top side
-    if (this->tiles[cornerX - 1][cornerY - 1]->checkHasRightWall() ||
-        this->tiles[cornerX - 1][cornerY - 1]->checkHasBottomWall() ||
-        this->tiles[cornerX + 1][cornerY - 1]->checkHasLeftWall() ||
-        this->tiles[cornerX + 1][cornerY - 1]->checkHasBottomWall()) {
+    if (this->getTile(cornerX - 1, cornerY - 1)->checkHasRightWall() ||
+        this->getTile(cornerX - 1, cornerY - 1)->checkHasBottomWall() ||
+        this->getTile(cornerX + 1, cornerY - 1)->checkHasLeftWall() ||
+        this->getTile(cornerX + 1, cornerY - 1)->checkHasBottomWall()) {
         if (side1 == 0 || side2 == 0) {// if one of the sides is the top side
             isValid = false;
         }
     }
 
     // Check diagonal tiles adjacent to the right side
-    if (this->tiles[cornerX + 1][cornerY - 1]->checkHasLeftWall() ||
-        this->tiles[cornerX + 1][cornerY - 1]->checkHasBottomWall() ||
-        this->tiles[cornerX + 1][cornerY + 1]->checkHasLeftWall() ||
-        this->tiles[cornerX + 1][cornerY + 1]->checkHasTopWall()) {
+    if (this->getTile(cornerX + 1, cornerY - 1)->checkHasLeftWall() ||
+        this->getTile(cornerX + 1, cornerY - 1)->checkHasBottomWall() ||
+        this->getTile(cornerX + 1, cornerY + 1)->checkHasLeftWall() ||
+        this->getTile(cornerX + 1, cornerY + 1)->checkHasTopWall()) {
         if (side1 == 1 || side2 == 1) {// if one of the sides is the right side
             isValid = false;
         }
     }
 
     // Check diagonal tiles adjacent to the bottom side
-    if (this->tiles[cornerX + 1][cornerY + 1]->checkHasLeftWall() ||
-        this->tiles[cornerX + 1][cornerY + 1]->checkHasTopWall() ||
-        this->tiles[cornerX - 1][cornerY + 1]->checkHasRightWall() ||
-        this->tiles[cornerX - 1][cornerY + 1]->checkHasTopWall()) {
+    if (this->getTile(cornerX + 1, cornerY + 1)->checkHasLeftWall() ||
+        this->getTile(cornerX + 1, cornerY + 1)->checkHasTopWall() ||
+        this->getTile(cornerX - 1, cornerY + 1)->checkHasRightWall() ||
+        this->getTile(cornerX - 1, cornerY + 1)->checkHasTopWall()) {
         if (side1 == 2 || side2 == 2) {// if one of the sides is the bottom side
             isValid = false;
         }
     }
 
     // Check diagonal tiles adjacent to the left side
-    if (this->tiles[cornerX - 1][cornerY + 1]->checkHasRightWall() ||
-        this->tiles[cornerX - 1][cornerY + 1]->checkHasTopWall() ||
-        this->tiles[cornerX - 1][cornerY - 1]->checkHasRightWall() ||
-        this->tiles[cornerX - 1][cornerY - 1]->checkHasBottomWall()) {
+    if (this->getTile(cornerX - 1, cornerY + 1)->checkHasRightWall() ||
+        this->getTile(cornerX - 1, cornerY + 1)->checkHasTopWall() ||
+        this->getTile(cornerX - 1, cornerY - 1)->checkHasRightWall() ||
+        this->getTile(cornerX - 1, cornerY - 1)->checkHasBottomWall()) {
         if (side1 == 3 || side2 == 3) {// if one of the sides is the left side
             isValid = false;
         }
@@ -367,20 +509,20 @@ void Board::placeCorner(int quarter, int corner) {
         // Set the walls on the tiles
         switch (side1) {
             case 0:
-                this->tiles[cornerX][cornerY]->setTopWall(true);
-                this->tiles[cornerX][cornerY - 1]->setBottomWall(true);
+                this->getTile(cornerX, cornerY)->setTopWall(true);
+                this->getTile(cornerX, cornerY - 1)->setBottomWall(true);
                 break;
             case 1:
-                this->tiles[cornerX][cornerY]->setRightWall(true);
-                this->tiles[cornerX + 1][cornerY]->setLeftWall(true);
+                this->getTile(cornerX, cornerY)->setRightWall(true);
+                this->getTile(cornerX + 1, cornerY)->setLeftWall(true);
                 break;
             case 2:
-                this->tiles[cornerX][cornerY]->setBottomWall(true);
-                this->tiles[cornerX][cornerY + 1]->setTopWall(true);
+                this->getTile(cornerX, cornerY)->setBottomWall(true);
+                this->getTile(cornerX, cornerY + 1)->setTopWall(true);
                 break;
             case 3:
-                this->tiles[cornerX][cornerY]->setLeftWall(true);
-                this->tiles[cornerX - 1][cornerY]->setRightWall(true);
+                this->getTile(cornerX, cornerY)->setLeftWall(true);
+                this->getTile(cornerX - 1, cornerY)->setRightWall(true);
                 break;
             default:
                 log(LogLevel::ERROR, "Unexpected side value: " + to_string(side1));
@@ -389,20 +531,20 @@ void Board::placeCorner(int quarter, int corner) {
 
         switch (side2) {
             case 0:
-                this->tiles[cornerX][cornerY]->setTopWall(true);
-                this->tiles[cornerX][cornerY - 1]->setBottomWall(true);
+                this->getTile(cornerX, cornerY)->setTopWall(true);
+                this->getTile(cornerX, cornerY - 1)->setBottomWall(true);
                 break;
             case 1:
-                this->tiles[cornerX][cornerY]->setRightWall(true);
-                this->tiles[cornerX + 1][cornerY]->setLeftWall(true);
+                this->getTile(cornerX, cornerY)->setRightWall(true);
+                this->getTile(cornerX + 1, cornerY)->setLeftWall(true);
                 break;
             case 2:
-                this->tiles[cornerX][cornerY]->setBottomWall(true);
-                this->tiles[cornerX][cornerY + 1]->setTopWall(true);
+                this->getTile(cornerX, cornerY)->setBottomWall(true);
+                this->getTile(cornerX, cornerY + 1)->setTopWall(true);
                 break;
             case 3:
-                this->tiles[cornerX][cornerY]->setLeftWall(true);
-                this->tiles[cornerX - 1][cornerY]->setRightWall(true);
+                this->getTile(cornerX, cornerY)->setLeftWall(true);
+                this->getTile(cornerX - 1, cornerY)->setRightWall(true);
                 break;
             default:
                 log(LogLevel::ERROR, "Unexpected side value: " + to_string(side2));
@@ -412,14 +554,14 @@ void Board::placeCorner(int quarter, int corner) {
         // Set the corner
         if (corner == 0) {
             // The multicolored target is handled separately from the other targets. The latter are handled in the placeTargets method.
-            this->tiles[cornerX][cornerY]->setHasTarget(true);
-            this->tiles[cornerX][cornerY]->setTargetSymbol('*');
-            this->tiles[cornerX][cornerY]->setTargetColor('M');
-            this->tiles[cornerX][cornerY]->setHasSpecialTarget(true);
-            this->targets.push_back(this->tiles[cornerX][cornerY]);
+            this->getTile(cornerX, cornerY)->setHasTarget(true);
+            this->getTile(cornerX, cornerY)->setTargetSymbol('*');
+            this->getTile(cornerX, cornerY)->setTargetColor('M');
+            this->getTile(cornerX, cornerY)->setHasSpecialTarget(true);
+            this->targets.push_back(cornerY * W + cornerX);
         }
         else {
-            this->tiles[cornerX][cornerY]->setHasCorner(true);
+            this->getTile(cornerX, cornerY)->setHasCorner(true);
         }
     }
 }
@@ -431,7 +573,8 @@ void Board::placeCorner(int quarter, int corner) {
  * - color "R", color "G", color "B" and color "Y"    
  * See the documentation for more information about the target placement.
  */
-void Board::placeTargets(){
+template<int W, int H, int R>
+void BasicBoard<W, H, R>::placeTargets(){
     vector<char> symbols = {'&', '#', '%', '$'};
     vector<char> colors = {'R', 'G', 'B', 'Y'};
     vector<Combination> combinations;
@@ -486,10 +629,10 @@ void Board::placeTargets(){
 
     //place the targets on the board
     for(int quarter = 0; quarter < 4; quarter++){
-        int minX = (quarter == 1 || quarter == 3) ? 0 : 8;
-        int maxX = (quarter == 1 || quarter == 3) ? 8 : 16;
-        int minY = (quarter == 1 || quarter == 2) ? 0 : 8;
-        int maxY = (quarter == 1 || quarter == 2) ? 8 : 16;
+        int minX = (quarter == 1 || quarter == 3) ? 0 : W / 2;
+        int maxX = (quarter == 1 || quarter == 3) ? W / 2 : W;
+        int minY = (quarter == 1 || quarter == 2) ? 0 : H / 2;
+        int maxY = (quarter == 1 || quarter == 2) ? H / 2 : H;
 
         //go through all the tiles in the quarter
         for (auto combination : vectors[quarter]) {
@@ -497,13 +640,13 @@ void Board::placeTargets(){
             for (int y = minY; y < maxY; y++) {
                 for (int x = minX; x < maxX; x++) {
                     // check if the tile has a corner
-                    if (this->tiles[x][y]->checkHasCorner()) {
+                    if (this->getTile(x, y)->checkHasCorner()) {
                         // check if the tile has a target
-                        if (!this->tiles[x][y]->checkHasTarget()) {
-                            this->tiles[x][y]->setHasTarget(true);
-                            this->tiles[x][y]->setTargetSymbol(combination[0]);
-                            this->tiles[x][y]->setTargetColor(combination[1]);
-                            this->targets.push_back(this->tiles[x][y]);
+                        if (!this->getTile(x, y)->checkHasTarget()) {
+                            this->getTile(x, y)->setHasTarget(true);
+                            this->getTile(x, y)->setTargetSymbol(combination[0]);
+                            this->getTile(x, y)->setTargetColor(combination[1]);
+                            this->targets.push_back(y * W + x);
                             targetPlaced = true;  // mark target as placed
                             //print the placed target
                             log(LogLevel::DEBUG, "Target of quarter " + to_string(quarter+1) +  " placed at (" + to_string(x) + ", " + to_string(y) + ") with symbol " + string(1, combination[0]) + " and color " + string(1, combination[1]));
@@ -526,7 +669,10 @@ void Board::placeTargets(){
  * @details The board will be drawn using the tiles in the board.
  * 
  */
-void Board::drawBoard(Tile* objectiveTile){
+template<int W, int H, int R>
+void BasicBoard<W, H, R>::drawBoard(Tile* objectiveTile){
+    const int HX = W / 2;
+    const int HY = H / 2;
     string objectiveTilePart1;
     string objectiveTilePart2;
     if (objectiveTile != nullptr) {
@@ -557,8 +703,8 @@ void Board::drawBoard(Tile* objectiveTile){
     }
     cout << "   ";
     // Write the numbers on the top
-    for (int i = 0; i < X_SIZE; i++) {
-        if (i == 15) {
+    for (int i = 0; i < W; i++) {
+        if (i == W - 1) {
             cout << " " << i << "  " << endl;
             break;
         }
@@ -573,61 +719,63 @@ void Board::drawBoard(Tile* objectiveTile){
 
     // Write the board
     // We go through all the tiles on the board
-    for (int y = 0; y < Y_SIZE; y++) {
+    for (int y = 0; y < H; y++) {
         // Write the top border
         if (y == 0) {
-            for (int x = 0; x < X_SIZE; x++) {
+            for (int x = 0; x < W; x++) {
                 if (x == 0) {
                     cout << "   ╔════";
                 } else {
-                    if (this->tiles[x][y]->checkHasLeftWall()) {
+                    if (this->getTile(x, y)->checkHasLeftWall()) {
                         cout << "╦════";
                     } else {
                         cout << "╤════";
                     }
                 }
-                if (x == 15) {
+                if (x == W - 1) {
                     cout << "╗" << endl;
                 }
             }
-            for (int x = 0; x < X_SIZE; x++) {
+            for (int x = 0; x < W; x++) {
                 // Write the left border of the first line's tiles
                 string robot;
-                if(this->tiles[x][y]->checkHasRobot()){
+                if(this->hasRobot(x, y)){
                     string color;
-                    if (this->tiles[x][y]->getRobotColor() == 'R') {
+                    if (this->getRobotColor(x, y) == 'R') {
                         color = red;
-                    } else if (this->tiles[x][y]->getRobotColor() == 'G') {
+                    } else if (this->getRobotColor(x, y) == 'G') {
                         color = green;
-                    } else if (this->tiles[x][y]->getRobotColor() == 'B') {
+                    } else if (this->getRobotColor(x, y) == 'B') {
                         color = cyan;
-                    } else if (this->tiles[x][y]->getRobotColor() == 'Y') {
+                    } else if (this->getRobotColor(x, y) == 'Y') {
                         color = yellow;
+                    } else if (this->getRobotColor(x, y) == 'S') {
+                        color = white;
                     }
                     robot = color + " ® " + reset + " ";
                 }
                 if (x == 0) {
-                    if (this->tiles[x][y]->checkHasRobot()){
+                    if (this->hasRobot(x, y)){
                         cout << " " << y << " ║"<< robot;
                     }else{
                         cout << " " << y << " ║    ";
                     }
                 } else {
-                    if (this->tiles[x][y]->checkHasLeftWall()) {
-                        if (this->tiles[x][y]->checkHasRobot()){
+                    if (this->getTile(x, y)->checkHasLeftWall()) {
+                        if (this->hasRobot(x, y)){
                             cout << "║"<< robot;
                         }else{
                             cout << "║    ";
                         }
                     } else {
-                        if (this->tiles[x][y]->checkHasRobot()){
+                        if (this->hasRobot(x, y)){
                             cout << "│" << robot;
                         }else{
                             cout << "│    ";
                         }
                     }
                 }
-                if (x == 15) {
+                if (x == W - 1) {
                     cout << "║" << endl;
                 }
             }
@@ -636,24 +784,24 @@ void Board::drawBoard(Tile* objectiveTile){
         // Write the rest of the board
         else {
             // Write the top side of the tiles
-            for (int x = 0; x < X_SIZE; x++) {
+            for (int x = 0; x < W; x++) {
                 if (x == 0) {
-                    if (this->tiles[x][y]->checkHasTopWall()) {
+                    if (this->getTile(x, y)->checkHasTopWall()) {
                         cout << "   ╠════";
                     } else {
                         cout << "   ╟────";
                     }
                 } else {
-                    if (this->tiles[x][y]->checkHasTopWall()) {
-                        if (this->tiles[x][y]->checkHasLeftWall()) {
+                    if (this->getTile(x, y)->checkHasTopWall()) {
+                        if (this->getTile(x, y)->checkHasLeftWall()) {
                             cout << "╔════";
-                        } else if (this->tiles[x][y - 1]->checkHasLeftWall()) {
+                        } else if (this->getTile(x, y - 1)->checkHasLeftWall()) {
                             cout << "╚════";
                         } else {
-                            if ((x == 8 && y == 7) || (x == 8 && y == 9)) {
-                                if (y == 7) {
+                            if ((x == HX && y == HY - 1) || (x == HX && y == HY + 1)) {
+                                if (y == HY - 1) {
                                     cout << "╧";
-                                } else if (y == 9) {
+                                } else if (y == HY + 1) {
                                     cout << "╤";
                                 }
                                 cout << "════";
@@ -661,36 +809,36 @@ void Board::drawBoard(Tile* objectiveTile){
                                 cout << "┤════";
                             }
                         }
-                    } else if (this->tiles[x - 1][y]->checkHasTopWall()) {
-                        if (this->tiles[x][y]->checkHasLeftWall()) {
+                    } else if (this->getTile(x - 1, y)->checkHasTopWall()) {
+                        if (this->getTile(x, y)->checkHasLeftWall()) {
                             cout << "╗────";
-                        } else if (this->tiles[x][y - 1]->checkHasLeftWall()) {
+                        } else if (this->getTile(x, y - 1)->checkHasLeftWall()) {
                             cout << "╝────";
                         } else {
                             cout << "├────";
                         }
-                    } else if (this->tiles[x][y]->checkHasLeftWall()) {
-                        if (x == 7 && y == 8 || x == 9 && y == 8) {
-                            if (x == 9) {
+                    } else if (this->getTile(x, y)->checkHasLeftWall()) {
+                        if (x == HX - 1 && y == HY || x == HX + 1 && y == HY) {
+                            if (x == HX + 1) {
                                 cout << "╟────";
-                            } else if (x == 7) {
+                            } else if (x == HX - 1) {
                                 cout << "╢  " + objectiveTilePart1;
                             }
                         } else {
                             cout << "┴────";
                         }
-                    } else if (this->tiles[x][y - 1]->checkHasLeftWall()) {
+                    } else if (this->getTile(x, y - 1)->checkHasLeftWall()) {
                         cout << "┬────";
                     } else {
-                        if (x == 8 && y == 8) {
+                        if (x == HX && y == HY) {
                             cout << objectiveTilePart2 + "  ";
                         } else {
                             cout << "┼────";
                         }
                     }
                 }
-                if (x == 15) {
-                    if (this->tiles[x][y]->checkHasTopWall()) {
+                if (x == W - 1) {
+                    if (this->getTile(x, y)->checkHasTopWall()) {
                         cout << "╣" << endl;
                     } else {
                         cout << "╢" << endl;
@@ -698,32 +846,46 @@ void Board::drawBoard(Tile* objectiveTile){
                 }
             }
             // Write the left side of the tiles
-            for (int x = 0; x < X_SIZE; x++) {
+            for (int x = 0; x < W; x++) {
                 string target = "";
                 string robot = "";
-                if(this->tiles[x][y]->checkHasTarget()){
+                if(this->getTile(x, y)->checkHasTarget()){
                     string color;
-                    if (this->tiles[x][y]->getTargetColor() == 'R') {
+                    if (this->getTile(x, y)->getTargetColor() == 'R') {
                         color = red;
-                    } else if (this->tiles[x][y]->getTargetColor() == 'G') {
+                    } else if (this->getTile(x, y)->getTargetColor() == 'G') {
                         color = green;
-                    } else if (this->tiles[x][y]->getTargetColor() == 'B') {
+                    } else if (this->getTile(x, y)->getTargetColor() == 'B') {
                         color = cyan;
-                    } else if (this->tiles[x][y]->getTargetColor() == 'Y') {
+                    } else if (this->getTile(x, y)->getTargetColor() == 'Y') {
                         color = yellow;
                     }
-                    target = color + " " + this->tiles[x][y]->getTargetSymbol()  + this->tiles[x][y]->getTargetSymbol() + " " + reset;
+                    target = color + " " + this->getTile(x, y)->getTargetSymbol()  + this->getTile(x, y)->getTargetSymbol() + " " + reset;
+                } else if (this->getTile(x, y)->getDeflector() != ' ') {
+                    string color;
+                    if (this->getTile(x, y)->getDeflectorColor() == 'R') {
+                        color = red;
+                    } else if (this->getTile(x, y)->getDeflectorColor() == 'G') {
+                        color = green;
+                    } else if (this->getTile(x, y)->getDeflectorColor() == 'B') {
+                        color = cyan;
+                    } else if (this->getTile(x, y)->getDeflectorColor() == 'Y') {
+                        color = yellow;
+                    }
+                    target = color + " " + this->getTile(x, y)->getDeflector() + this->getTile(x, y)->getDeflector() + " " + reset;
                 }
-                if(this->tiles[x][y]->checkHasRobot()){
+                if(this->hasRobot(x, y)){
                     string color;
-                    if (this->tiles[x][y]->getRobotColor() == 'R') {
+                    if (this->getRobotColor(x, y) == 'R') {
                         color = red;
-                    } else if (this->tiles[x][y]->getRobotColor() == 'G') {
+                    } else if (this->getRobotColor(x, y) == 'G') {
                         color = green;
-                    } else if (this->tiles[x][y]->getRobotColor() == 'B') {
+                    } else if (this->getRobotColor(x, y) == 'B') {
                         color = cyan;
-                    } else if (this->tiles[x][y]->getRobotColor() == 'Y') {
+                    } else if (this->getRobotColor(x, y) == 'Y') {
                         color = yellow;
+                    } else if (this->getRobotColor(x, y) == 'S') {
+                        color = white;
                     }
                     robot = color + " ® " + reset + " ";
                 }
@@ -733,37 +895,37 @@ void Board::drawBoard(Tile* objectiveTile){
                         cout << " " << y;
                     else
                         cout << y;
-                    if (this->tiles[x][y]->checkHasLeftWall()) {
-                        if (this->tiles[x][y]->checkHasSpecialTarget() && !this->tiles[x][y]->checkHasRobot()) {
+                    if (this->getTile(x, y)->checkHasLeftWall()) {
+                        if (this->getTile(x, y)->checkHasSpecialTarget() && !this->hasRobot(x, y)) {
                             cout << " ║" << red << " " << green << "*" << cyan << "*" << yellow << " " << reset;
-                        }else if (this->tiles[x][y]->checkHasTarget() && !this->tiles[x][y]->checkHasRobot()) {
+                        }else if (!target.empty() && !this->hasRobot(x, y)) {
                             cout << " ║" << target;
-                        }else if (this->tiles[x][y]->checkHasRobot()) {
+                        }else if (this->hasRobot(x, y)) {
                             cout << " ║" << robot;
                         } else {
                             cout << " ║    ";
                         }
                     }
                 } else {
-                    if (this->tiles[x][y]->checkHasLeftWall()) {
-                        if (this->tiles[x][y]->checkHasSpecialTarget() && !this->tiles[x][y]->checkHasRobot()) {
+                    if (this->getTile(x, y)->checkHasLeftWall()) {
+                        if (this->getTile(x, y)->checkHasSpecialTarget() && !this->hasRobot(x, y)) {
                             cout << "║" << red << " " << green << "*" << cyan << "*" << yellow << " " << reset;
-                        }else if (this->tiles[x][y]->checkHasTarget() && !this->tiles[x][y]->checkHasRobot()) {
+                        }else if (!target.empty() && !this->hasRobot(x, y)) {
                             cout << "║" << target;
-                        }else if (this->tiles[x][y]->checkHasRobot()) {
+                        }else if (this->hasRobot(x, y)) {
                             cout << "║" << robot;
                         } else {
                             cout << "║    ";
                         }
                     } else {
-                        if ((x == 8 && y == 7) || (x == 8 && y == 8)) {
+                        if ((x == HX && y == HY - 1) || (x == HX && y == HY)) {
                             cout << "     ";
                         } else {
-                            if (this->tiles[x][y]->checkHasSpecialTarget() && !this->tiles[x][y]->checkHasRobot()) {
+                            if (this->getTile(x, y)->checkHasSpecialTarget() && !this->hasRobot(x, y)) {
                                 cout << "│" <<red << " " << green << "*" << cyan << "*" << yellow << " " << reset;
-                            }else if (this->tiles[x][y]->checkHasTarget() && !this->tiles[x][y]->checkHasRobot()) {
+                            }else if (!target.empty() && !this->hasRobot(x, y)) {
                                 cout << "│" << target;
-                            }else if (this->tiles[x][y]->checkHasRobot()){
+                            }else if (this->hasRobot(x, y)){
                                 cout << "│" << robot;
                             }else {
                                 cout << "│    ";
@@ -771,25 +933,25 @@ void Board::drawBoard(Tile* objectiveTile){
                         }
                     }
                 }
-                if (x == 15) {
+                if (x == W - 1) {
                     cout << "║" << endl;
                 }
             }
         }
 
         // Write the bottom border
-        if (y == 15) {
-            for (int x = 0; x < X_SIZE; x++) {
+        if (y == H - 1) {
+            for (int x = 0; x < W; x++) {
                 if (x == 0) {
                     cout << "   ╚════";
                 } else {
-                    if (this->tiles[x][y]->checkHasLeftWall()) {
+                    if (this->getTile(x, y)->checkHasLeftWall()) {
                         cout << "╩════";
                     } else {
                         cout << "╧════";
                     }
                 }
-                if (x == 15) {
+                if (x == W - 1) {
                     cout << "╝" << endl;
                 }
             }
@@ -798,3 +960,588 @@ void Board::drawBoard(Tile* objectiveTile){
     log(LogLevel::INFO, "Board drawn");
     
 }
+
+/**
+ * @brief The computeStops method builds the table of the cells where a robot stops from each cell and in each direction, counting only the walls.
+ * @details Each row and column is swept once per direction: the stop of a cell is the cell itself if it has a wall on that side, otherwise the stop of its neighbour.
+ * It must be called again whenever walls are changed, except through setWall which updates the table itself. The current snapshot is dropped, as it no longer matches the board, and the paths of the diagonal variant are computed again.
+ */
+template<int W, int H, int R>
+void BasicBoard<W, H, R>::computeStops(){
+    this->snapshot.reset();
+    this->revision++;
+    for(int y = 0; y < H; y++){
+        // East and west along the row
+        for(int x = W - 1; x >= 0; x--){
+            int cell = y * W + x;
+            bool wall = x == W - 1 || this->getTile(x, y)->checkHasRightWall();
+            this->stops[cell][1] = wall ? cell : this->stops[cell + 1][1];
+        }
+        for(int x = 0; x < W; x++){
+            int cell = y * W + x;
+            bool wall = x == 0 || this->getTile(x, y)->checkHasLeftWall();
+            this->stops[cell][3] = wall ? cell : this->stops[cell - 1][3];
+        }
+    }
+    for(int x = 0; x < W; x++){
+        // North and south along the column
+        for(int y = 0; y < H; y++){
+            int cell = y * W + x;
+            bool wall = y == 0 || this->getTile(x, y)->checkHasTopWall();
+            this->stops[cell][0] = wall ? cell : this->stops[cell - W][0];
+        }
+        for(int y = H - 1; y >= 0; y--){
+            int cell = y * W + x;
+            bool wall = y == H - 1 || this->getTile(x, y)->checkHasBottomWall();
+            this->stops[cell][2] = wall ? cell : this->stops[cell + W][2];
+        }
+    }
+    this->computeTrajectories();
+}
+
+/**
+ * @brief The getStop method returns the cell where a robot stops when it moves from a cell in a direction, counting only the walls.
+ * 
+ * @param cell The starting cell
+ * @param direction 0 = N, 1 = E, 2 = S, 3 = W
+ * @return int 
+ */
+template<int W, int H, int R>
+int BasicBoard<W, H, R>::getStop(int cell, int direction){
+    return this->stops[cell][direction];
+}
+
+/**
+ * @brief The getStop method returns the cell where a robot stops when it moves from a cell in a direction, counting the walls and the other robots.
+ * 
+ * @param cell The starting cell
+ * @param direction 0 = N, 1 = E, 2 = S, 3 = W
+ * @param robotCells The cells of the robots, the moving robot included
+ * @param robotCount The number of robots
+ * @return int 
+ */
+template<int W, int H, int R>
+int BasicBoard<W, H, R>::getStop(int cell, int direction, const int robotCells[], int robotCount){
+    int stop = this->stops[cell][direction];
+    for(int i = 0; i < robotCount; i++){
+        stop = trimStop(cell, direction, stop, robotCells[i]);
+    }
+    return stop;
+}
+
+/**
+ * @brief The trimStop method shortens a move if a robot stands between the starting cell and the stop.
+ * 
+ * @param cell The starting cell
+ * @param direction 0 = N, 1 = E, 2 = S, 3 = W
+ * @param stop The current stop of the move
+ * @param robotCell The cell of the robot that may block the move
+ * @return The new stop, next to the robot if it blocks the move
+ */
+template<int W, int H, int R>
+int BasicBoard<W, H, R>::trimStop(int cell, int direction, int stop, int robotCell){
+    switch(direction){
+        case 0:
+            if(robotCell < cell && robotCell >= stop && (cell - robotCell) % W == 0) return robotCell + W;
+            break;
+        case 1:
+            if(robotCell > cell && robotCell <= stop) return robotCell - 1;
+            break;
+        case 2:
+            if(robotCell > cell && robotCell <= stop && (robotCell - cell) % W == 0) return robotCell - W;
+            break;
+        case 3:
+            if(robotCell < cell && robotCell >= stop) return robotCell + 1;
+            break;
+    }
+    return stop;
+}
+
+/**
+ * @brief The buildBitBoard method copies the walls and the robots of the tiles into the bitboard.
+ * @details It must be called again whenever walls are changed. Robots are then kept up to date by placeRobot and move.
+ */
+template<int W, int H, int R>
+void BasicBoard<W, H, R>::buildBitBoard(){
+    this->bitboard.clear();
+    for(int x = 0; x < W; x++){
+        for(int y = 0; y < H; y++){
+            Tile* tile = this->getTile(x, y);
+            if(tile->checkHasTopWall()) this->bitboard.setWall(x, y, 0, true);
+            if(tile->checkHasRightWall()) this->bitboard.setWall(x, y, 1, true);
+            if(tile->checkHasBottomWall()) this->bitboard.setWall(x, y, 2, true);
+            if(tile->checkHasLeftWall()) this->bitboard.setWall(x, y, 3, true);
+        }
+    }
+    for(int i = 0; i < R; i++){
+        if(this->robotCells[i] != -1){
+            this->bitboard.setRobot(this->robotCells[i] % W, this->robotCells[i] / W, true);
+        }
+    }
+}
+
+/**
+ * @brief The getBitBoard method returns the bitboard representation of the board.
+ * 
+ * @return BitBoard* 
+ */
+template<int W, int H, int R>
+BasicBitBoard<W, H>* BasicBoard<W, H, R>::getBitBoard(){
+    return &this->bitboard;
+}
+
+/**
+ * @brief The getReachableCells method returns the cells that any robot can reach in one move.
+ * 
+ * @return Bits<W * H> 
+ */
+template<int W, int H, int R>
+Bits<W * H> BasicBoard<W, H, R>::getReachableCells(){
+    if(!this->trajectories){
+        return this->bitboard.getReachableCells();
+    }
+    // The bitboard only knows straight moves, deflected ones are followed one robot at a time
+    Bits<W * H> cells;
+    for(int robot = 0; robot < R; robot++){
+        if(this->robotCells[robot] == -1) continue;
+        for(int direction = 0; direction < 4; direction++){
+            int stop = this->slide(robot, direction);
+            if(stop != this->robotCells[robot]){
+                cells.set(stop);
+            }
+        }
+    }
+    return cells;
+}
+
+/**
+ * @brief The placeRobot method puts a robot on the board.
+ * 
+ * @param robot The number of the robot
+ * @param cell The cell of the robot
+ * @param color The color of the robot
+ */
+template<int W, int H, int R>
+void BasicBoard<W, H, R>::placeRobot(int robot, int cell, char color){
+    if(this->robotColors[robot] != color){
+        // The snapshot keeps the colors of the robots for the deflectors
+        this->snapshot.reset();
+    }
+    this->robotColors[robot] = color;
+    this->move(robot, cell);
+}
+
+/**
+ * @brief The removeRobots method takes all the robots off the board.
+ * 
+ */
+template<int W, int H, int R>
+void BasicBoard<W, H, R>::removeRobots(){
+    for(int i = 0; i < R; i++){
+        if(this->robotCells[i] != -1){
+            this->bitboard.setRobot(this->robotCells[i] % W, this->robotCells[i] / W, false);
+        }
+        this->robotCells[i] = -1;
+        this->robotColors[i] = ' ';
+    }
+}
+
+/**
+ * @brief The robotAt method returns the robot standing on a cell.
+ * 
+ * @param cell 
+ * @return The number of the robot, or -1 if the cell is empty
+ */
+template<int W, int H, int R>
+int BasicBoard<W, H, R>::robotAt(int cell){
+    if(!this->bitboard.hasRobot(cell % W, cell / W)){
+        return -1;
+    }
+    for(int i = 0; i < R; i++){
+        if(this->robotCells[i] == cell){
+            return i;
+        }
+    }
+    return -1;
+}
+
+/**
+ * @brief The cellOf method returns the cell of a robot.
+ * 
+ * @param robot The number of the robot
+ * @return The cell of the robot, or -1 if it is not on the board
+ */
+template<int W, int H, int R>
+int BasicBoard<W, H, R>::cellOf(int robot){
+    return this->robotCells[robot];
+}
+
+/**
+ * @brief The move method moves a robot to a cell, keeping the robots mask and the robot cells in sync.
+ * @details A cell is only cleared in the mask if no other robot is left on it, so robots can be moved back to their base positions in any order.
+ * 
+ * @param robot The number of the robot
+ * @param to The new cell of the robot
+ */
+template<int W, int H, int R>
+void BasicBoard<W, H, R>::move(int robot, int to){
+    int from = this->robotCells[robot];
+    this->robotCells[robot] = to;
+    if(from != -1 && this->robotAt(from) == -1){
+        this->bitboard.setRobot(from % W, from / W, false);
+    }
+    this->bitboard.setRobot(to % W, to / W, true);
+}
+
+/**
+ * @brief The hasRobot method checks if a robot stands on a tile.
+ * 
+ * @param x X coordinate
+ * @param y Y coordinate
+ * @return true 
+ * @return false 
+ */
+template<int W, int H, int R>
+bool BasicBoard<W, H, R>::hasRobot(int x, int y){
+    return this->bitboard.hasRobot(x, y);
+}
+
+/**
+ * @brief The getRobotColor method returns the color of the robot standing on a tile.
+ * 
+ * @param x X coordinate
+ * @param y Y coordinate
+ * @return The color of the robot, or ' ' if the tile is empty
+ */
+template<int W, int H, int R>
+char BasicBoard<W, H, R>::getRobotColor(int x, int y){
+    int robot = this->robotAt(y * W + x);
+    return robot == -1 ? ' ' : this->robotColors[robot];
+}
+
+/**
+ * @brief The getRobotCells method returns the cells of all the robots, indexed by robot number.
+ * 
+ * @return const int* 
+ */
+template<int W, int H, int R>
+const int* BasicBoard<W, H, R>::getRobotCells(){
+    return this->robotCells;
+}
+
+/**
+ * @brief The getSnapshot method returns an immutable copy of the walls, targets and stop table of the board.
+ * @details The snapshot is built on the first call and shared by every later call until the walls change, so it costs nothing to hand it to solvers or to other threads.
+ * 
+ * @return shared_ptr<const BoardSnapshot> 
+ */
+template<int W, int H, int R>
+shared_ptr<const BoardSnapshot> BasicBoard<W, H, R>::getSnapshot(){
+    this->refreshTrajectories();
+    if(!this->snapshot){
+        unsigned char walls[W * H];
+        for(int cell = 0; cell < W * H; cell++){
+            walls[cell] = this->tiles[cell].getWalls();
+        }
+        vector<SnapshotTarget> targets;
+        for(int i = 0; i < this->targets.size(); i++){
+            Tile* target = this->getTarget(i);
+            targets.push_back({this->targets[i], target->getTargetColor(), target->getTargetSymbol()});
+        }
+        this->snapshot = make_shared<const BoardSnapshot>(walls, this->stops, targets, this->trajectories, this->robotColors);
+    }
+    return this->snapshot;
+}
+
+/**
+ * @brief The getRobotState method returns the current cells of the robots as a RobotState.
+ * 
+ * @return RobotState 
+ */
+template<int W, int H, int R>
+RobotState BasicBoard<W, H, R>::getRobotState(){
+    return RobotState(this->robotCells);
+}
+
+/**
+ * @brief The updateRowStops method recomputes the east and west stops of the cells of a row segment.
+ * @details The segment is first widened to the walls on both ends, as the stops of the cells between two walls only depend on the walls in between. Cells outside of it are not affected.
+ * 
+ * @param y The row
+ * @param from The first cell of the row to update
+ * @param to The last cell of the row to update
+ */
+template<int W, int H, int R>
+void BasicBoard<W, H, R>::updateRowStops(int y, int from, int to){
+    while(from > 0 && !this->getTile(from, y)->checkHasLeftWall()) from--;
+    while(to < W - 1 && !this->getTile(to, y)->checkHasRightWall()) to++;
+    for(int x = to; x >= from; x--){
+        int cell = y * W + x;
+        bool wall = x == W - 1 || this->getTile(x, y)->checkHasRightWall();
+        this->stops[cell][1] = wall ? cell : this->stops[cell + 1][1];
+    }
+    for(int x = from; x <= to; x++){
+        int cell = y * W + x;
+        bool wall = x == 0 || this->getTile(x, y)->checkHasLeftWall();
+        this->stops[cell][3] = wall ? cell : this->stops[cell - 1][3];
+    }
+}
+
+/**
+ * @brief The updateColumnStops method recomputes the north and south stops of the cells of a column segment.
+ * @details Same as updateRowStops, along a column.
+ * 
+ * @param x The column
+ * @param from The first cell of the column to update
+ * @param to The last cell of the column to update
+ */
+template<int W, int H, int R>
+void BasicBoard<W, H, R>::updateColumnStops(int x, int from, int to){
+    while(from > 0 && !this->getTile(x, from)->checkHasTopWall()) from--;
+    while(to < H - 1 && !this->getTile(x, to)->checkHasBottomWall()) to++;
+    for(int y = from; y <= to; y++){
+        int cell = y * W + x;
+        bool wall = y == 0 || this->getTile(x, y)->checkHasTopWall();
+        this->stops[cell][0] = wall ? cell : this->stops[cell - W][0];
+    }
+    for(int y = to; y >= from; y--){
+        int cell = y * W + x;
+        bool wall = y == H - 1 || this->getTile(x, y)->checkHasBottomWall();
+        this->stops[cell][2] = wall ? cell : this->stops[cell + W][2];
+    }
+}
+
+/**
+ * @brief The setWall method adds or removes a wall on one side of a tile, for the board editor.
+ * @details The wall is shared by the two tiles on each side of it, so both are updated, in the tiles and in the bitboard. Only the stops of the row or column segment crossing the wall are recomputed. On a board with deflectors, a path can cross the whole board, so the paths are marked stale and all computed again on the next move or snapshot, once for a whole series of edits. The snapshot is likewise only rebuilt when next requested.
+ * The walls on the edges of the board cannot be removed.
+ * 
+ * @param x 
+ * @param y 
+ * @param direction 0 = N, 1 = E, 2 = S, 3 = W
+ * @param wall true to add the wall, false to remove it
+ * @return true if the board now has the requested wall
+ * @return false if the position is invalid or the wall is on the edge of the board
+ */
+template<int W, int H, int R>
+bool BasicBoard<W, H, R>::setWall(int x, int y, int direction, bool wall){
+    const int dx[4] = {0, 1, 0, -1};
+    const int dy[4] = {-1, 0, 1, 0};
+    if(x < 0 || x >= W || y < 0 || y >= H || direction < 0 || direction > 3){
+        log(LogLevel::WARNING, "Invalid wall position");
+        return false;
+    }
+    int nx = x + dx[direction];
+    int ny = y + dy[direction];
+    if(nx < 0 || nx >= W || ny < 0 || ny >= H){
+        log(LogLevel::WARNING, "The walls on the edges of the board cannot be changed");
+        return false;
+    }
+    if(((this->getTile(x, y)->getWalls() >> direction) & 1) == wall){
+        return true;
+    }
+    int opposite = (direction + 2) % 4;
+    this->getTile(x, y)->setWall(direction, wall);
+    this->getTile(nx, ny)->setWall(opposite, wall);
+    this->bitboard.setWall(x, y, direction, wall);
+    this->bitboard.setWall(nx, ny, opposite, wall);
+    if(direction == 1 || direction == 3){
+        this->updateRowStops(y, min(x, nx), max(x, nx));
+    }else{
+        this->updateColumnStops(x, min(y, ny), max(y, ny));
+    }
+    // The paths of the diagonal variant and the snapshot are rebuilt when next used, not after each wall
+    if(this->trajectories){
+        this->trajectoriesStale = true;
+    }
+    this->snapshot.reset();
+    this->revision++;
+    return true;
+}
+
+/**
+ * @brief The toggleWall method adds a wall on one side of a tile if there is none, or removes it.
+ * 
+ * @param x 
+ * @param y 
+ * @param direction 0 = N, 1 = E, 2 = S, 3 = W
+ * @return true if the wall was toggled
+ * @return false if the position is invalid or the wall is on the edge of the board
+ */
+template<int W, int H, int R>
+bool BasicBoard<W, H, R>::toggleWall(int x, int y, int direction){
+    if(x < 0 || x >= W || y < 0 || y >= H || direction < 0 || direction > 3){
+        log(LogLevel::WARNING, "Invalid wall position");
+        return false;
+    }
+    return this->setWall(x, y, direction, !((this->getTile(x, y)->getWalls() >> direction) & 1));
+}
+
+/**
+ * @brief The getRevision method returns a number that changes every time the walls of the board change.
+ * @details Results computed from the board (solutions, tables) can keep the revision they were computed for and compare it to tell if they are stale.
+ * 
+ * @return unsigned long 
+ */
+template<int W, int H, int R>
+unsigned long BasicBoard<W, H, R>::getRevision(){
+    return this->revision;
+}
+
+/**
+ * @brief The slide method returns the cell where a robot stops when it moves in a direction, counting the walls, the deflectors and the other robots.
+ * @details Without deflectors this is the stop table trimmed to the nearest robot, as in getStop. With deflectors, the path of the robot is read from the trajectory table: a straight path is trimmed the same way, a bent one stops before the first robot found along it.
+ * 
+ * @param robot The robot to move
+ * @param direction 0 = N, 1 = E, 2 = S, 3 = W
+ * @return int 
+ */
+template<int W, int H, int R>
+int BasicBoard<W, H, R>::slide(int robot, int direction){
+    int cell = this->robotCells[robot];
+    if(!this->trajectories){
+        return this->getStop(cell, direction, this->robotCells, R);
+    }
+    this->refreshTrajectories();
+    const Trajectory& path = this->trajectories->get(TrajectoryTable::colorIndex(this->robotColors[robot]), cell, direction);
+    if(path.bent){
+        for(int i = 0; i < path.length; i++){
+            int next = this->trajectories->getCell(path, i);
+            if(this->bitboard.hasRobot(next % W, next / W)){
+                return i == 0 ? cell : this->trajectories->getCell(path, i - 1);
+            }
+        }
+        return this->trajectories->getEnd(path, cell);
+    }
+    int stop = this->trajectories->getEnd(path, cell);
+    for(int i = 0; i < R; i++){
+        stop = trimStop(cell, direction, stop, this->robotCells[i]);
+    }
+    return stop;
+}
+
+/**
+ * @brief The placeDeflectors method adds diagonal deflectors on random empty tiles, for the diagonal variant.
+ * @details A deflector is never put on the edges of the board, next to a wall, on a target, on a robot or next to another deflector. Its color is one of the four target colors.
+ * 
+ * @param count The number of deflectors to add
+ */
+template<int W, int H, int R>
+void BasicBoard<W, H, R>::placeDeflectors(int count){
+    random_device rd;
+    mt19937 gen(rd());
+    this->placeDeflectors(count, gen);
+}
+
+/**
+ * @brief The placeDeflectors method adds diagonal deflectors on empty tiles drawn from a generator, so that the same generator gives the same deflectors.
+ * @details Same rules as placeDeflectors(int).
+ * 
+ * @param count The number of deflectors to add
+ * @param gen The generator the tiles, kinds and colors are drawn from
+ */
+template<int W, int H, int R>
+void BasicBoard<W, H, R>::placeDeflectors(int count, mt19937& gen){
+    const char kinds[2] = {'/', '\\'};
+    const char colors[4] = {'R', 'G', 'B', 'Y'};
+    uniform_int_distribution<int> xDist(1, W - 2);
+    uniform_int_distribution<int> yDist(1, H - 2);
+    uniform_int_distribution<int> kindDist(0, 1);
+    uniform_int_distribution<int> colorDist(0, 3);
+    int placed = 0;
+    for(int tries = 0; placed < count && tries < 100 * count; tries++){
+        int x = xDist(gen);
+        int y = yDist(gen);
+        Tile* tile = this->getTile(x, y);
+        if(tile->checkHasWall() || tile->checkHasTarget() || tile->checkHasCorner() || tile->checkIsCentralTile() || tile->getDeflector() != ' ' || this->hasRobot(x, y)){
+            continue;
+        }
+        if(this->getTile(x - 1, y)->getDeflector() != ' ' || this->getTile(x + 1, y)->getDeflector() != ' ' ||
+           this->getTile(x, y - 1)->getDeflector() != ' ' || this->getTile(x, y + 1)->getDeflector() != ' '){
+            continue;
+        }
+        tile->setDeflector(kinds[kindDist(gen)], colors[colorDist(gen)]);
+        log(LogLevel::DEBUG, "Deflector " + string(1, tile->getDeflector()) + " of color " + string(1, tile->getDeflectorColor()) + " placed at (" + to_string(x) + ", " + to_string(y) + ")");
+        placed++;
+    }
+    this->computeTrajectories();
+    this->revision++;
+}
+
+/**
+ * @brief The computeTrajectories method builds the path of a robot of each color from each cell in each direction.
+ * @details A robot goes on until it meets a wall or comes back to its starting cell. On a deflector of another color it turns: a '/' sends north to east, east to north, south to west and west to south, a '\\' sends north to west, west to north, south to east and east to south.
+ * The table is only built when the board has deflectors, otherwise the stop table is enough.
+ */
+template<int W, int H, int R>
+void BasicBoard<W, H, R>::computeTrajectories(){
+    const int dx[4] = {0, 1, 0, -1};
+    const int dy[4] = {-1, 0, 1, 0};
+    const int slash[4] = {1, 0, 3, 2};
+    const int backslash[4] = {3, 2, 1, 0};
+    this->snapshot.reset();
+    this->trajectoriesStale = false;
+    bool hasDeflectors = false;
+    for(int cell = 0; cell < W * H && !hasDeflectors; cell++){
+        hasDeflectors = this->tiles[cell].getDeflector() != ' ';
+    }
+    if(!hasDeflectors){
+        this->trajectories.reset();
+        return;
+    }
+    shared_ptr<TrajectoryTable> table = make_shared<TrajectoryTable>(W * H);
+    vector<uint16_t> path;
+    for(int color = 0; color <= DEFLECTOR_COLOR_COUNT; color++){
+        char robotColor = color < DEFLECTOR_COLOR_COUNT ? DEFLECTOR_COLORS[color] : ' ';
+        for(int cell = 0; cell < W * H; cell++){
+            for(int direction = 0; direction < 4; direction++){
+                path.clear();
+                bool bent = false;
+                int x = cell % W;
+                int y = cell / W;
+                int d = direction;
+                while(path.size() < 4 * W * H){
+                    int nx = x + dx[d];
+                    int ny = y + dy[d];
+                    if(((this->getTile(x, y)->getWalls() >> d) & 1) || nx < 0 || nx >= W || ny < 0 || ny >= H || ny * W + nx == cell){
+                        break;
+                    }
+                    x = nx;
+                    y = ny;
+                    path.push_back(y * W + x);
+                    Tile* tile = this->getTile(x, y);
+                    if(tile->getDeflector() != ' ' && tile->getDeflectorColor() != robotColor){
+                        d = tile->getDeflector() == '/' ? slash[d] : backslash[d];
+                        bent = true;
+                    }
+                }
+                table->addPath(color, cell, direction, path, bent);
+            }
+        }
+    }
+    this->trajectories = table;
+}
+
+/**
+ * @brief The getTrajectories method returns the paths of the diagonal variant.
+ * 
+ * @return The trajectory table, or nullptr if the board has no deflectors
+ */
+template<int W, int H, int R>
+shared_ptr<const TrajectoryTable> BasicBoard<W, H, R>::getTrajectories(){
+    this->refreshTrajectories();
+    return this->trajectories;
+}
+
+/**
+ * @brief The refreshTrajectories method computes the paths of the diagonal variant again if walls were edited since they were last computed.
+ * @details setWall only marks the paths as stale, as a wall can bend any number of them.
+ */
+template<int W, int H, int R>
+void BasicBoard<W, H, R>::refreshTrajectories(){
+    if(this->trajectoriesStale){
+        this->computeTrajectories();
+    }
+}
+
+template class BasicBoard<BOARD_SIZE, BOARD_SIZE, BOARD_ROBOTS>;
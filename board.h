@@ -13,31 +13,115 @@
 #define BOARD_H
 
 #include "tile.h"
+#include "bitboard.h"
+#include "trajectory.h"
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <type_traits>
 #include <vector>
 
-const int X_SIZE = 16;
-const int Y_SIZE = 16; 
+#ifndef BOARD_SIZE
+#define BOARD_SIZE 16
+#endif
+
+#ifndef BOARD_ROBOTS
+#define BOARD_ROBOTS 4
+#endif
+
+class BoardSnapshot;
+class RobotState;
 
 /**
- * @brief The Board class represents the game board.
- * @details The game board is a 16x16 grid. Each tile on the game board can have walls on one or more of its sides, a target and/or a robot.
+ * @brief The BasicBoard class represents a W x H game board with R robots.
+ * @details The classic game board is a 16x16 grid with 4 robots. Each tile on the game board can have walls on one or more of its sides, a target and/or a robot.
+ * Cells are numbered y * W + x and directions 0 = N, 1 = E, 2 = S, 3 = W. The board keeps a table of the cell where a robot stops when it moves in each direction from each cell, counting only the walls.
+ * The tiles are stored by value in one contiguous array, row by row, and the targets are kept as cell numbers. Alongside the tiles, the walls and the robots are also kept as bit masks in a BasicBitBoard for bulk queries.
+ * In the diagonal variant some tiles hold colored deflectors. The path of a robot of each color from each cell in each direction is then precomputed in a TrajectoryTable, and slide follows it instead of the stop table.
+ * Instead of being generated, a 16x16 board can also be assembled from the printed quarters of the original game with assembleClassicBoard.
+ * getSnapshot returns an immutable, shared copy of the walls, targets and stop table that can be explored with RobotState overlays without touching the board.
+ * The board is the only owner of the robot positions: the robots mask of the bitboard and the cell of each robot are updated together by placeRobot and move, and every other class reads the positions from there.
+ * Walls can be edited one side at a time with setWall: only the row or column segment around the edited wall is recomputed in the stop table and the bitboard, and the revision number goes up so that cached results (snapshots, solutions) can tell they are stale. The snapshot and the paths of the diagonal variant are only rebuilt when next needed, so a series of edits pays for them once.
+ * The size and the number of robots are template parameters, so the cell and state types are chosen at compile time: a cell fits in 8 bits up to 256 cells and in 10 bits up to 1024 cells, and a state packs the cells of all the robots in 32 bits when it can, 64 bits otherwise.
  */
-class Board{
+template<int W, int H, int R>
+class BasicBoard{
+    public:
+        static const int WIDTH = W;
+        static const int HEIGHT = H;
+        static const int ROBOTS = R;
+        static const int CELLS = W * H;
+        static const int CELL_BITS = CELLS <= 256 ? 8 : 10;
+        typedef typename conditional<CELLS <= 256, uint8_t, uint16_t>::type Cell;
+        typedef typename conditional<CELL_BITS * R <= 32, uint32_t, uint64_t>::type StateType;
+        static_assert(CELLS <= 1024, "boards are limited to 1024 cells");
+        static_assert(CELL_BITS * R <= 64, "the cells of all the robots must fit in 64 bits");
+
     private:
-        Tile* tiles[X_SIZE][Y_SIZE];
-        vector<Tile*> targets;
+        Tile tiles[W * H];
+        vector<int> targets;
+        Cell stops[W * H][4];
+        BasicBitBoard<W, H> bitboard;
+        int robotCells[R];
+        char robotColors[R];
+        shared_ptr<const BoardSnapshot> snapshot;
+        shared_ptr<const TrajectoryTable> trajectories;
+        bool trajectoriesStale;
+        unsigned long revision;
+
+        void updateRowStops(int y, int from, int to);
+        void updateColumnStops(int x, int from, int to);
+        void refreshTrajectories();
 
     public:
-        Board();
-        Board(Tile* t[X_SIZE][Y_SIZE]);
+        BasicBoard();
+        BasicBoard(Tile* t[W][H]);
         Tile* getTile(int x, int y);
+        int getCell(Tile* tile);
         Tile* getTarget(int i);
         void setTile(int x, int y, Tile* t);
+        void clear();
         void initializeBoard();
+        bool assembleClassicBoard(int layout);
+        int getTargetCount();
         void placeWalls();
         void placeCorner(int quarter, int corner);
         void placeTargets();
         void drawBoard(Tile* objectiveTile);
+        void computeStops();
+        int getStop(int cell, int direction);
+        int getStop(int cell, int direction, const int robotCells[], int robotCount);
+        static int trimStop(int cell, int direction, int stop, int robotCell);
+        void buildBitBoard();
+        BasicBitBoard<W, H>* getBitBoard();
+        Bits<W * H> getReachableCells();
+        void placeRobot(int robot, int cell, char color);
+        void removeRobots();
+        int robotAt(int cell);
+        int cellOf(int robot);
+        void move(int robot, int to);
+        bool hasRobot(int x, int y);
+        char getRobotColor(int x, int y);
+        const int* getRobotCells();
+        shared_ptr<const BoardSnapshot> getSnapshot();
+        RobotState getRobotState();
+        int slide(int robot, int direction);
+        void placeDeflectors(int count);
+        void placeDeflectors(int count, mt19937& gen);
+        void computeTrajectories();
+        shared_ptr<const TrajectoryTable> getTrajectories();
+        bool setWall(int x, int y, int direction, bool wall);
+        bool toggleWall(int x, int y, int direction);
+        unsigned long getRevision();
 };
 
+/**
+ * The board used by the game, chosen at compile time with -DBOARD_SIZE and -DBOARD_ROBOTS (16 and 4 by default).
+ */
+typedef BasicBoard<BOARD_SIZE, BOARD_SIZE, BOARD_ROBOTS> Board;
+
+const int X_SIZE = Board::WIDTH;
+const int Y_SIZE = Board::HEIGHT;
+const int ROBOT_COUNT = Board::ROBOTS;
+
 #endif // BOARD_H
\ No newline at end of file
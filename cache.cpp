@@ -0,0 +1,487 @@
+/**
+ * @file cache.cpp
+ * @author Bastien
+ * @brief Class for the cache of the solutions kept from one run to the next (Implementation File)
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+#include "cache.h"
+#include "log.h"
+#include <algorithm>
+#include <cstdio>
+#include <climits>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/**
+ * The first bytes of a cache file, followed by the version of the format.
+ */
+const char CACHE_MAGIC[4] = {'R', 'R', 'S', 'C'};
+const uint32_t CACHE_VERSION = 1;
+
+/**
+ * @brief The header of a cache file: the solutions of a build with another number of cells or robots cannot be used.
+ */
+struct CacheHeader{
+    char magic[4];
+    uint32_t version;
+    uint32_t cells;
+    uint32_t robots;
+};
+
+/**
+ * @brief A solution in the cache file, followed by its moves (robot * 4 + direction, one byte each) padded to 8 bytes.
+ * @details The check covers the rest of the record, so a record cut short or garbled by a crash is found when the file is opened.
+ */
+struct CacheRecord{
+    uint64_t key;
+    uint32_t check;
+    uint8_t solved;
+    uint8_t count;
+    uint16_t reserved;
+};
+
+/**
+ * @brief Returns the number of bytes of a record with a number of moves
+ *
+ * @param count
+ * @return size_t
+ */
+static size_t recordSize(int count){
+    return sizeof(CacheRecord) + (count + 7) / 8 * 8;
+}
+
+/**
+ * @brief Returns the check of a record, a hash of its key, its flags and its moves
+ *
+ * @param record
+ * @param moves
+ * @return uint32_t
+ */
+static uint32_t checkRecord(const CacheRecord& record, const unsigned char* moves){
+    uint32_t check = 2166136261u;
+    auto add = [&](unsigned char byte){
+        check = (check ^ byte) * 16777619u;
+    };
+    for(int i = 0; i < 8; i++){
+        add(record.key >> (8 * i));
+    }
+    add(record.solved);
+    add(record.count);
+    for(int i = 0; i < record.count; i++){
+        add(moves[i]);
+    }
+    return check;
+}
+
+/**
+ * @brief Returns a value mixed into a hash, every bit of the value changing about half of the bits of the result
+ *
+ * @param hash
+ * @param value
+ * @return uint64_t
+ */
+static uint64_t mix(uint64_t hash, uint64_t value){
+    uint64_t x = hash ^ (value + 0x9e3779b97f4a7c15ull);
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ull;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebull;
+    return x ^ (x >> 31);
+}
+
+/**
+ * @brief Construct a new SolutionCache:: SolutionCache object
+ * @details If the file cannot be opened, the cache stays empty and nothing is saved.
+ *
+ * @param path The file of the cache, created if it does not exist
+ * @param maxBytes The largest size of the file
+ */
+SolutionCache::SolutionCache(const string& path, size_t maxBytes){
+    this->path = path;
+    this->maxBytes = max(maxBytes, 2 * (sizeof(CacheHeader) + recordSize(UCHAR_MAX)));
+    this->file = -1;
+    this->mapping = nullptr;
+    this->mappingSize = 0;
+    this->used = 0;
+    this->hits = 0;
+    this->misses = 0;
+    this->evictions = 0;
+    if(this->open()){
+        if(this->used > this->maxBytes){
+            this->compact();
+        }
+        flock(this->file, LOCK_UN);
+    }
+}
+
+/**
+ * @brief Destroy the SolutionCache:: SolutionCache object
+ *
+ */
+SolutionCache::~SolutionCache(){
+    this->close();
+}
+
+/**
+ * @brief The open function maps the file and indexes its solutions
+ * @details The file is locked against the other processes using it, and stays locked when the function returns true. A file with the header of another format, or ending with a broken record, is replaced by a new file holding only its valid records.
+ *
+ * @return false if the file cannot be used
+ */
+bool SolutionCache::open(){
+    while(true){
+        this->file = ::open(this->path.c_str(), O_RDWR | O_CREAT, 0644);
+        if(this->file == -1){
+            log(LogLevel::WARNING, "Could not open solution cache " + this->path);
+            return false;
+        }
+        struct stat current;
+        struct stat status;
+        if(flock(this->file, LOCK_EX) != 0 || fstat(this->file, &status) != 0){
+            this->close();
+            return false;
+        }
+        // Another process may have replaced the file while this one waited for the lock
+        if(stat(this->path.c_str(), &current) != 0 || current.st_ino != status.st_ino || current.st_dev != status.st_dev){
+            this->close();
+            continue;
+        }
+        size_t size = status.st_size;
+        CacheHeader header;
+        bool valid = size >= sizeof(header) && pread(this->file, &header, sizeof(header), 0) == sizeof(header) && memcmp(header.magic, CACHE_MAGIC, 4) == 0 && header.version == CACHE_VERSION && header.cells == CELL_COUNT && header.robots == ROBOT_COUNT;
+        if(!valid && size > 0){
+            log(LogLevel::WARNING, "Solution cache " + this->path + " is not in the format of this build, starting over");
+            bool written = this->rewrite(vector<size_t>());
+            this->close();
+            if(!written){
+                return false;
+            }
+            continue;
+        }
+        if(!valid){
+            memset(&header, 0, sizeof(header));
+            memcpy(header.magic, CACHE_MAGIC, 4);
+            header.version = CACHE_VERSION;
+            header.cells = CELL_COUNT;
+            header.robots = ROBOT_COUNT;
+            if(pwrite(this->file, &header, sizeof(header), 0) != sizeof(header)){
+                log(LogLevel::WARNING, "Could not write solution cache " + this->path);
+                this->close();
+                return false;
+            }
+            size = sizeof(header);
+        }
+
+        // The mapping covers the largest size, so the records appended later can be read through it
+        this->mappingSize = max(size, this->maxBytes);
+        void* mapping = mmap(nullptr, this->mappingSize, PROT_READ, MAP_SHARED, this->file, 0);
+        if(mapping == MAP_FAILED){
+            log(LogLevel::WARNING, "Could not map solution cache " + this->path);
+            this->mappingSize = 0;
+            this->close();
+            return false;
+        }
+        this->mapping = (const unsigned char*)mapping;
+
+        this->used = sizeof(header);
+        if(!this->scan(size)){
+            if(!this->repair()){
+                return false;
+            }
+            continue;
+        }
+        log(LogLevel::DEBUG, "Solution cache " + this->path + " opened with " + to_string(this->index.size()) + " solutions");
+        return true;
+    }
+}
+
+/**
+ * @brief The scan function indexes the records appended since the last scan
+ * @details A record that does not pass its check is the end of the file as far as the cache goes: the records after it are not indexed, and the file has to be repaired before anything is appended to it.
+ *
+ * @param size The size of the file
+ * @return false if the file ends with a broken record
+ */
+bool SolutionCache::scan(size_t size){
+    size = min(size, this->mappingSize);
+    size_t offset = this->used;
+    while(offset + sizeof(CacheRecord) <= size){
+        const CacheRecord* record = (const CacheRecord*)(this->mapping + offset);
+        if(offset + recordSize(record->count) > size || record->check != checkRecord(*record, this->mapping + offset + sizeof(CacheRecord))){
+            break;
+        }
+        this->index[record->key] = offset;
+        offset += recordSize(record->count);
+    }
+    this->used = offset;
+    return offset == size;
+}
+
+/**
+ * @brief The repair function replaces a file ending with a broken record by a new file holding the records indexed
+ * @details It is called with the file locked, and closes it: the caller opens the new file.
+ *
+ * @return false if the new file cannot be written
+ */
+bool SolutionCache::repair(){
+    log(LogLevel::WARNING, "Solution cache " + this->path + " ends with a broken record, it is dropped");
+    vector<size_t> offsets;
+    for(const auto& entry : this->index){
+        offsets.push_back(entry.second);
+    }
+    sort(offsets.begin(), offsets.end());
+    bool written = this->rewrite(offsets);
+    this->close();
+    return written;
+}
+
+/**
+ * @brief The refresh function catches up with the other processes using the same file
+ * @details It is called with the file locked. The records they appended are indexed, and if one of them replaced the file (see rewrite), or if the file no longer holds the records indexed, the file is opened again, and locked in turn.
+ *
+ * @return false if the file cannot be used anymore
+ */
+bool SolutionCache::refresh(){
+    struct stat current;
+    struct stat status;
+    if(stat(this->path.c_str(), &current) != 0 || fstat(this->file, &status) != 0 || current.st_ino != status.st_ino || current.st_dev != status.st_dev || (size_t)status.st_size < this->used){
+        this->close();
+        return this->open();
+    }
+    if(!this->scan(status.st_size)){
+        return this->repair() && this->open();
+    }
+    return true;
+}
+
+/**
+ * @brief The close function unmaps and closes the file, the index being emptied
+ *
+ */
+void SolutionCache::close(){
+    if(this->mapping != nullptr){
+        munmap((void*)this->mapping, this->mappingSize);
+        this->mapping = nullptr;
+        this->mappingSize = 0;
+    }
+    if(this->file != -1){
+        ::close(this->file);
+        this->file = -1;
+    }
+    this->index.clear();
+    this->used = 0;
+}
+
+/**
+ * @brief The rewrite function replaces the file by a new one holding some of its records
+ * @details The new file is written next to the old one and renamed over it, so the processes still reading the old file through their mapping are not disturbed. It is called with the old file locked.
+ *
+ * @param offsets The offsets of the records to keep, in the order they are written
+ * @return false if the new file cannot be written
+ */
+bool SolutionCache::rewrite(const vector<size_t>& offsets){
+    CacheHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, CACHE_MAGIC, 4);
+    header.version = CACHE_VERSION;
+    header.cells = CELL_COUNT;
+    header.robots = ROBOT_COUNT;
+    string temporary = this->path + "." + to_string(getpid()) + ".tmp";
+    FILE* output = fopen(temporary.c_str(), "wb");
+    bool written = output != nullptr && fwrite(&header, sizeof(header), 1, output) == 1;
+    for(size_t i = 0; written && i < offsets.size(); i++){
+        written = fwrite(this->mapping + offsets[i], recordSize(((const CacheRecord*)(this->mapping + offsets[i]))->count), 1, output) == 1;
+    }
+    if(output != nullptr && fclose(output) != 0){
+        written = false;
+    }
+    if(!written || rename(temporary.c_str(), this->path.c_str()) != 0){
+        log(LogLevel::WARNING, "Could not write solution cache " + this->path);
+        remove(temporary.c_str());
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief The compact function replaces the file by one with its newest solutions only
+ * @details The newest records filling half of the largest size are kept, so the file is not rewritten again before many insertions. It is called with the file locked, and the new file is locked in turn: the other processes open it at their next insertion. If the new file cannot be written, the old one is kept, full: no solution is added to it anymore.
+ *
+ */
+void SolutionCache::compact(){
+    vector<size_t> offsets;
+    for(const auto& entry : this->index){
+        offsets.push_back(entry.second);
+    }
+    sort(offsets.begin(), offsets.end());
+    size_t budget = this->maxBytes / 2 - sizeof(CacheHeader);
+    size_t kept = 0;
+    size_t first = offsets.size();
+    while(first > 0){
+        size_t size = recordSize(((const CacheRecord*)(this->mapping + offsets[first - 1]))->count);
+        if(kept + size > budget){
+            break;
+        }
+        kept += size;
+        first--;
+    }
+    if(!this->rewrite(vector<size_t>(offsets.begin() + first, offsets.end()))){
+        return;
+    }
+    this->evictions += first;
+    log(LogLevel::DEBUG, "Solution cache " + this->path + " full, " + to_string(first) + " solutions evicted");
+    this->close();
+    this->open();
+}
+
+/**
+ * @brief The getKey function returns the key of a round in the cache
+ *
+ * @param board The snapshot of the board
+ * @param start The cells of the robots
+ * @param targetCell The cell to reach
+ * @param targetRobot The robot that has to reach the cell, or -1 if any robot can reach it
+ * @return uint64_t
+ */
+uint64_t SolutionCache::getKey(const BoardSnapshot& board, State start, int targetCell, int targetRobot){
+    uint64_t key = mix(board.getHash(), start);
+    for(int i = 0; i < ROBOT_COUNT; i++){
+        key = mix(key, board.getPathGroup(i));
+    }
+    key = mix(key, targetCell);
+    return mix(key, targetRobot + 1);
+}
+
+/**
+ * @brief The find function looks for the solution of a round
+ *
+ * @param key The key of the round, see getKey
+ * @param solution Set to the solution cached, if any
+ * @return true if the round is in the cache
+ * @return false
+ */
+bool SolutionCache::find(uint64_t key, Solution& solution){
+    lock_guard<mutex> guard(this->lock);
+    auto found = this->index.find(key);
+    if(found == this->index.end()){
+        this->misses++;
+        return false;
+    }
+    this->hits++;
+    const CacheRecord* record = (const CacheRecord*)(this->mapping + found->second);
+    const unsigned char* moves = this->mapping + found->second + sizeof(CacheRecord);
+    solution.solved = record->solved != 0;
+    solution.nodes = 0;
+    solution.moves.clear();
+    for(int i = 0; i < record->count; i++){
+        solution.moves.push_back({moves[i] / 4, Solver::directionToChar(moves[i] % 4)});
+    }
+    return true;
+}
+
+/**
+ * @brief The insert function appends the solution of a round to the cache
+ * @details A round already in the cache is left as it is, and so is a solution too long to be stored (more than 255 moves).
+ *
+ * @param key The key of the round, see getKey
+ * @param solution An optimal solution, or an unsolved one if the round cannot be solved
+ */
+void SolutionCache::insert(uint64_t key, const Solution& solution){
+    lock_guard<mutex> guard(this->lock);
+    if(this->file == -1 || this->index.count(key) != 0 || solution.moves.size() > UCHAR_MAX){
+        return;
+    }
+    if(flock(this->file, LOCK_EX) != 0){
+        return;
+    }
+    if(!this->refresh()){
+        return;
+    }
+    size_t size = recordSize(solution.moves.size());
+    if(this->index.count(key) == 0 && this->used + size > this->maxBytes){
+        this->compact();
+    }
+    // The file stays full if it could not be compacted
+    if(this->file != -1 && this->index.count(key) == 0 && this->used + size <= this->maxBytes){
+        this->append(key, solution);
+    }
+    if(this->file != -1){
+        flock(this->file, LOCK_UN);
+    }
+}
+
+/**
+ * @brief The append function writes a solution at the end of the file, which is locked
+ *
+ * @param key
+ * @param solution
+ */
+void SolutionCache::append(uint64_t key, const Solution& solution){
+    size_t size = recordSize(solution.moves.size());
+    vector<unsigned char> buffer(size, 0);
+    CacheRecord record;
+    memset(&record, 0, sizeof(record));
+    record.key = key;
+    record.solved = solution.solved;
+    record.count = solution.moves.size();
+    unsigned char* moves = buffer.data() + sizeof(CacheRecord);
+    const string directions = "NESW";
+    for(int i = 0; i < record.count; i++){
+        moves[i] = solution.moves[i].robot * 4 + directions.find(solution.moves[i].direction);
+    }
+    record.check = checkRecord(record, moves);
+    memcpy(buffer.data(), &record, sizeof(record));
+    if(pwrite(this->file, buffer.data(), size, this->used) != (ssize_t)size){
+        log(LogLevel::WARNING, "Could not write solution cache " + this->path);
+        return;
+    }
+    this->index[key] = this->used;
+    this->used += size;
+}
+
+/**
+ * @brief The size function returns the number of solutions in the cache
+ *
+ * @return size_t
+ */
+size_t SolutionCache::size() const{
+    lock_guard<mutex> guard(this->lock);
+    return this->index.size();
+}
+
+/**
+ * @brief The getHits function returns the number of lookups that found their round
+ *
+ * @return uint64_t
+ */
+uint64_t SolutionCache::getHits() const{
+    lock_guard<mutex> guard(this->lock);
+    return this->hits;
+}
+
+/**
+ * @brief The getMisses function returns the number of lookups that did not find their round
+ *
+ * @return uint64_t
+ */
+uint64_t SolutionCache::getMisses() const{
+    lock_guard<mutex> guard(this->lock);
+    return this->misses;
+}
+
+/**
+ * @brief The getEvictions function returns the number of solutions dropped to keep the file under its largest size
+ *
+ * @return uint64_t
+ */
+uint64_t SolutionCache::getEvictions() const{
+    lock_guard<mutex> guard(this->lock);
+    return this->evictions;
+}
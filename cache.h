@@ -0,0 +1,74 @@
+/**
+ * @file cache.h
+ * @author Bastien
+ * @brief Class for the cache of the solutions kept from one run to the next
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+#ifndef CACHE_H
+#define CACHE_H
+
+#include "solver.h"
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+/**
+ * The file the solutions are cached in, relative to the working directory. It is named after the size of the board and the number of robots, so the builds for other boards keep their own file.
+ */
+const string CACHE_PATH = "solutions-" + to_string(X_SIZE) + "x" + to_string(Y_SIZE) + "-" + to_string(ROBOT_COUNT) + ".cache";
+
+/**
+ * The largest size of the cache file, the oldest solutions being evicted past it.
+ */
+const size_t CACHE_MAX_BYTES = 64 << 20;
+
+/**
+ * @brief The SolutionCache class keeps the optimal solutions of the rounds already solved, in a file shared by every run.
+ * @details A solution is found by a 64-bit key hashing the board (its walls, targets and deflectors, see BoardSnapshot::getHash, and the paths of the robots), the cells of the robots and the target. Two positions with the same key are taken to be the same, which is safe as long as far fewer than 2^32 positions are cached.
+ * The file is only ever appended to, and read through a read-only shared mapping: an in-memory index gives the place of each solution, so a lookup is a hash table probe and a few reads. The index is rebuilt by reading the file when the cache is opened, a record cut short by a crash being dropped.
+ * When the file would grow past its largest size, it is rewritten with its newest half only (the older solutions are evicted). The file is never truncated, as the other processes may be reading it through their mapping: it is always replaced by a new file, which they open at their next insertion.
+ * Only the solutions proven optimal, or the positions proven unsolvable, should be inserted. The cache is thread safe. Several processes can share the file, each appending under a lock: the solutions inserted by the others are indexed at the next insertion.
+ */
+class SolutionCache{
+    private:
+        string path;
+        size_t maxBytes;
+        int file;
+        const unsigned char* mapping;
+        size_t mappingSize;
+        size_t used;
+        unordered_map<uint64_t, size_t> index;
+        mutable mutex lock;
+        uint64_t hits;
+        uint64_t misses;
+        uint64_t evictions;
+
+        bool open();
+        bool scan(size_t size);
+        bool repair();
+        bool refresh();
+        void close();
+        bool rewrite(const vector<size_t>& offsets);
+        void compact();
+        void append(uint64_t key, const Solution& solution);
+
+    public:
+        SolutionCache(const string& path = CACHE_PATH, size_t maxBytes = CACHE_MAX_BYTES);
+        ~SolutionCache();
+        SolutionCache(const SolutionCache&) = delete;
+        SolutionCache& operator=(const SolutionCache&) = delete;
+        static uint64_t getKey(const BoardSnapshot& board, State start, int targetCell, int targetRobot);
+        bool find(uint64_t key, Solution& solution);
+        void insert(uint64_t key, const Solution& solution);
+        size_t size() const;
+        uint64_t getHits() const;
+        uint64_t getMisses() const;
+        uint64_t getEvictions() const;
+};
+
+#endif // CACHE_H
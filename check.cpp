@@ -0,0 +1,358 @@
+/**
+ * @file check.cpp
+ * @author Bastien
+ * @brief Main file for checking every solver against the breadth-first solver
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+#include "anytime.h"
+#include "bidirectional.h"
+#include "cache.h"
+#include "evaluator.h"
+#include "external.h"
+#include "ida.h"
+#include "log.h"
+#include "parallel.h"
+#include "sample.h"
+#include "tablebase.h"
+#include <climits>
+#include <cstdio>
+#include <filesystem>
+#include <functional>
+#include <iostream>
+
+/**
+ * The largest tablebase built for the check: only the builds with few robots get one, a full tablebase of the classic game takes far longer than the rest of the check.
+ */
+const uint64_t CHECK_TABLEBASE_MAX_ENTRIES = 1 << 24;
+
+/**
+ * The number of rounds whose board gets every target solved at once by Solver::solveAll, each target being checked: the search goes on until the hardest target of the board is solved, about a second with 4 robots.
+ */
+const int CHECK_ALL_TARGETS_ROUNDS = 5;
+
+/**
+ * One round in this many is drawn on a board with the diagonal deflectors of the variant (see sampleDeflectorBoard), where the solvers take their paths from the trajectory table and have no reverse moves.
+ */
+const int CHECK_DEFLECTOR_SHARE = 4;
+
+/**
+ * The solution cache the solutions of the check are written to and read back from, removed at the start and at the end of the check.
+ */
+const string CHECK_CACHE_PATH = "solutions-check.cache";
+
+/**
+ * The directory the pattern databases of the check are saved in and loaded from, removed at the start and at the end of the check.
+ */
+const string CHECK_PATTERN_DIRECTORY = "patterns-check";
+
+/**
+ * @brief A solver checked against the breadth-first solver, and the number of rounds it got wrong
+ */
+struct Checked{
+  string name;
+  function<Solution(shared_ptr<const BoardSnapshot>, const SampleRound&)> solve;
+  int rounds = 0;
+  int failures = 0;
+};
+
+/**
+ * @brief A round written to the solution cache, with the board and the breadth-first solution it was written with
+ */
+struct Written{
+  shared_ptr<const BoardSnapshot> board;
+  SampleRound round;
+  Solution solution;
+};
+
+/**
+ * @brief The isValid function plays a solution and checks that it ends on the target
+ *
+ * @param board
+ * @param round
+ * @param solution
+ * @return true if the solution is solved and reaches the target
+ */
+bool isValid(const BoardSnapshot& board, const SampleRound& round, const Solution& solution){
+  const string directions = "NESW";
+  RobotState robots(round.start);
+  for(const Move& move : solution.moves){
+    if(move.robot < 0 || move.robot >= ROBOT_COUNT || directions.find(move.direction) == string::npos){
+      return false;
+    }
+    robots.move(move.robot, board.slide(robots, move.robot, directions.find(move.direction)));
+  }
+  for(int i = 0; i < ROBOT_COUNT; i++){
+    if((round.targetRobot == -1 || round.targetRobot == i) && robots.cellOf(i) == round.targetCell){
+      return true;
+    }
+  }
+  return false;
+}
+
+/**
+ * @brief The check function compares a solution with the one of the breadth-first solver: same number of moves, or both unsolved, and a valid play
+ *
+ * @param checked
+ * @param board
+ * @param round
+ * @param reference
+ * @param solution
+ * @param index The number of the round, for the report
+ */
+void check(Checked& checked, const BoardSnapshot& board, const SampleRound& round, const Solution& reference, const Solution& solution, int index){
+  checked.rounds++;
+  bool same = solution.solved == reference.solved && (!solution.solved || solution.moves.size() == reference.moves.size());
+  if(same && (!solution.solved || isValid(board, round, solution))){
+    return;
+  }
+  checked.failures++;
+  cout << "Round " << index << ": " << checked.name << " gives " << (solution.solved ? to_string(solution.moves.size()) + " moves" : "no solution");
+  cout << ", breadth-first search gives " << (reference.solved ? to_string(reference.moves.size()) + " moves" : "no solution") << (same ? ", and its moves do not reach the target" : "") << endl;
+}
+
+/**
+ * @brief The solveWithoutSymmetry function runs a breadth-first search on the real states, without swapping any robot
+ * @details The breadth-first solver searches canonical states (see Symmetry): both give the same number of moves only if the canonical form keeps the solutions of the round.
+ *
+ * @param board
+ * @param round
+ * @return Solution
+ */
+Solution solveWithoutSymmetry(const BoardSnapshot& board, const SampleRound& round){
+  auto isGoal = [&](State state){
+    for(int i = 0; i < ROBOT_COUNT; i++){
+      if((round.targetRobot == -1 || round.targetRobot == i) && Solver::getRobotCell(state, i) == round.targetCell){
+        return true;
+      }
+    }
+    return false;
+  };
+  Solution solution = {false, {}, 0};
+  ParentMap parents;
+  parents[round.start] = make_pair(round.start, 0);
+  vector<State> frontier(1, round.start);
+  State goal = round.start;
+  bool found = isGoal(round.start);
+  State successors[MOVE_COUNT];
+  while(!found && !frontier.empty()){
+    vector<State> next;
+    for(size_t i = 0; i < frontier.size() && !found; i++){
+      board.expand(&frontier[i], 1, successors);
+      solution.nodes++;
+      for(int j = 0; j < MOVE_COUNT && !found; j++){
+        if(successors[j] == frontier[i] || !parents.emplace(successors[j], make_pair(frontier[i], (unsigned char)j)).second){
+          continue;
+        }
+        next.push_back(successors[j]);
+        if(isGoal(successors[j])){
+          goal = successors[j];
+          found = true;
+        }
+      }
+    }
+    frontier.swap(next);
+  }
+  if(!found){
+    return solution;
+  }
+  for(State state = goal; state != round.start; state = parents[state].first){
+    unsigned char move = parents[state].second;
+    solution.moves.push_back({move / 4, Solver::directionToChar(move % 4)});
+  }
+  reverse(solution.moves.begin(), solution.moves.end());
+  solution.solved = true;
+  return solution;
+}
+
+/**
+ * @brief The checkEvaluator function evaluates every position of the breadth-first solution of a round, with the anytime search of the round handed to the evaluator as in the game
+ * @details A position after k of the n moves of an optimal solution is n - k moves away from the target: an exact evaluation must give that, a lower bound must not be above it. The evaluator is not told the solution (see Evaluator::learn), so each position is searched.
+ *
+ * @param checked
+ * @param board
+ * @param round
+ * @param reference The solution of the breadth-first solver
+ * @param index The number of the round, for the report
+ */
+void checkEvaluator(Checked& checked, shared_ptr<const BoardSnapshot> board, const SampleRound& round, const Solution& reference, int index){
+  const string directions = "NESW";
+  shared_ptr<AnytimeSolver> anytime = make_shared<AnytimeSolver>(board);
+  anytime->solve(round.start, round.targetCell, round.targetRobot, chrono::steady_clock::time_point::max());
+  Evaluator evaluator(board, round.targetCell, round.targetRobot);
+  evaluator.useRoundSearch(anytime->getExactSolver(), anytime->getLowerBound());
+  checked.rounds++;
+  RobotState robots(round.start);
+  int moves = reference.solved ? reference.moves.size() : 0;
+  for(int k = 0; k <= moves; k++){
+    int expected = reference.solved ? moves - k : INT_MAX;
+    Evaluation evaluation = evaluator.evaluate(robots.getState());
+    if(evaluation.exact ? evaluation.distance != expected : evaluation.distance > expected){
+      checked.failures++;
+      cout << "Round " << index << ": evaluator gives " << (evaluation.exact ? "" : "at least ") << evaluation.distance << " moves after " << k << " moves, breadth-first search gives " << (reference.solved ? to_string(expected) : "no solution") << endl;
+      return;
+    }
+    if(k < moves){
+      const Move& move = reference.moves[k];
+      robots.move(move.robot, board->slide(robots, move.robot, directions.find(move.direction)));
+    }
+  }
+}
+
+int main(int argc, char* argv[])
+{
+  setLogLevel(LogLevel::NONE);
+
+  int count = 30;
+  unsigned seed = 1;
+  for(int i = 1; i < argc; i++){
+    string argument = argv[i];
+    if(argument == "-r" && i + 1 < argc && atoi(argv[i + 1]) > 0){
+      count = atoi(argv[++i]);
+    }else if(argument == "-s" && i + 1 < argc){
+      seed = strtoul(argv[++i], nullptr, 10);
+    }else{
+      cerr << "Usage: " << argv[0] << " [-r rounds] [-s seed]" << endl;
+      cerr << "Solves the same rounds with every solver and checks them against the breadth-first solver, as well as the evaluator of the demonstrations, the pattern databases and the solution cache." << endl;
+      return 1;
+    }
+  }
+
+  vector<Checked> solvers = {
+    {"breadth-first without symmetry", [](shared_ptr<const BoardSnapshot> board, const SampleRound& round){
+      return solveWithoutSymmetry(*board, round);
+    }},
+    {"anytime", [](shared_ptr<const BoardSnapshot> board, const SampleRound& round){
+      return AnytimeSolver(board).solve(round.start, round.targetCell, round.targetRobot, chrono::steady_clock::time_point::max());
+    }},
+    {"iterative deepening", [](shared_ptr<const BoardSnapshot> board, const SampleRound& round){
+      IdaSolver solver(board);
+      solver.setPatterns(make_shared<PatternStore>(board, CHECK_PATTERN_DIRECTORY));
+      return solver.solve(round.start, round.targetCell, round.targetRobot);
+    }},
+    // A new store reads the pattern databases the previous solver saved, as the next run would
+    {"iterative deepening, pattern databases from disk", [](shared_ptr<const BoardSnapshot> board, const SampleRound& round){
+      IdaSolver solver(board);
+      solver.setPatterns(make_shared<PatternStore>(board, CHECK_PATTERN_DIRECTORY));
+      return solver.solve(round.start, round.targetCell, round.targetRobot);
+    }},
+    {"parallel breadth-first", [](shared_ptr<const BoardSnapshot> board, const SampleRound& round){
+      return ParallelSolver(board, 2).solve(round.start, round.targetCell, round.targetRobot);
+    }},
+    {"bidirectional", [](shared_ptr<const BoardSnapshot> board, const SampleRound& round){
+      return BidirectionalSolver(board).solve(round.start, round.targetCell, round.targetRobot);
+    }},
+    {"external breadth-first", [](shared_ptr<const BoardSnapshot> board, const SampleRound& round){
+      return ExternalSolver(board).solve(round.start, round.targetCell, round.targetRobot);
+    }}
+  };
+  Checked allTargets;
+  allTargets.name = "solve all targets";
+  Checked evaluators;
+  evaluators.name = "evaluator";
+  Checked tablebases;
+  tablebases.name = "tablebase";
+  Checked cached;
+  cached.name = "solution cache";
+  // The rounds and their solutions, read back from the solution cache at the end
+  vector<Written> written;
+  remove(CHECK_CACHE_PATH.c_str());
+  filesystem::remove_all(CHECK_PATTERN_DIRECTORY);
+  unique_ptr<SolutionCache> cache = make_unique<SolutionCache>(CHECK_CACHE_PATH);
+
+  mt19937 gen(seed);
+  Board board;
+  int deflected = 0;
+  for(int i = 0; i < count; i++){
+    if(i % CHECK_DEFLECTOR_SHARE == CHECK_DEFLECTOR_SHARE - 1){
+      sampleDeflectorBoard(&board, gen);
+      deflected++;
+    }else{
+      sampleBoard(&board, gen);
+    }
+    SampleRound round = sampleRound(&board, gen);
+    shared_ptr<const BoardSnapshot> snapshot = board.getSnapshot();
+    Solution reference = Solver(snapshot).solve(round.start, round.targetCell, round.targetRobot);
+    if(reference.solved && !isValid(*snapshot, round, reference)){
+      cout << "Round " << i << ": the moves of breadth-first search do not reach the target" << endl;
+      return 1;
+    }
+    for(Checked& solver : solvers){
+      check(solver, *snapshot, round, reference, solver.solve(snapshot, round), i);
+    }
+    checkEvaluator(evaluators, snapshot, round, reference, i);
+    cache->insert(SolutionCache::getKey(*snapshot, round.start, round.targetCell, round.targetRobot), reference);
+    written.push_back({snapshot, round, reference});
+
+    // Every target of the board from the same robots, the robot of each target being the one of its color (any robot for the multicolored target)
+    if(i < CHECK_ALL_TARGETS_ROUNDS && snapshot->getTargetCount() > 0){
+      vector<Solution> solutions = Solver(snapshot).solveAll(round.start, ROBOT_COLORS);
+      for(int t = 0; t < snapshot->getTargetCount(); t++){
+        SampleRound targetRound = round;
+        targetRound.targetCell = snapshot->getTarget(t).cell;
+        targetRound.targetRobot = -1;
+        for(int r = 0; r < ROBOT_COUNT; r++){
+          if(ROBOT_COLORS[r] == snapshot->getTarget(t).color){
+            targetRound.targetRobot = r;
+          }
+        }
+        if(targetRound.targetRobot == -1 && snapshot->getTarget(t).color != 'M'){
+          continue;
+        }
+        Solution expected = Solver(snapshot).solve(targetRound.start, targetRound.targetCell, targetRound.targetRobot);
+        check(allTargets, *snapshot, targetRound, expected, solutions[t], i);
+      }
+    }
+
+    Tablebase tablebase(snapshot, round.targetCell, round.targetRobot);
+    if(tablebase.getEntryCount() <= CHECK_TABLEBASE_MAX_ENTRIES && tablebase.build()){
+      // The tablebase stops at its depth, deeper rounds are left unknown
+      Solution expected = reference;
+      if(reference.solved && (int)reference.moves.size() > tablebase.getMaxDepth()){
+        expected.solved = false;
+      }
+      if(!reference.solved || !expected.solved){
+        expected.moves.clear();
+      }
+      check(tablebases, *snapshot, round, expected, tablebase.solve(round.start), i);
+    }
+  }
+
+  // The solutions are read back from the file by a new cache, as by the next run of the game
+  cache = make_unique<SolutionCache>(CHECK_CACHE_PATH);
+  for(int i = 0; i < written.size(); i++){
+    const Written& round = written[i];
+    Solution solution;
+    if(!cache->find(SolutionCache::getKey(*round.board, round.round.start, round.round.targetCell, round.round.targetRobot), solution)){
+      cached.rounds++;
+      cached.failures++;
+      cout << "Round " << i << ": solution cache lost the solution" << endl;
+      continue;
+    }
+    check(cached, *round.board, round.round, round.solution, solution, i);
+  }
+  cache = nullptr;
+  remove(CHECK_CACHE_PATH.c_str());
+  filesystem::remove_all(CHECK_PATTERN_DIRECTORY);
+
+  solvers.push_back(allTargets);
+  solvers.push_back(evaluators);
+  solvers.push_back(tablebases);
+  solvers.push_back(cached);
+
+  cout << count << " rounds on " << X_SIZE << "x" << Y_SIZE << " with " << ROBOT_COUNT << " robots, " << deflected << " with deflectors, seed " << seed << endl;
+  int failures = 0;
+  for(const Checked& solver : solvers){
+    if(solver.rounds == 0){
+      cout << solver.name << ": not checked, too large for this board" << endl;
+      continue;
+    }
+    cout << solver.name << ": " << solver.rounds << " rounds, " << solver.failures << " wrong" << endl;
+    failures += solver.failures;
+  }
+  return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,133 @@
+/**
+ * @file evaluator.cpp
+ * @author Bastien
+ * @brief Class for the evaluation of the positions reached during a demonstration (Implementation File)
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+#include "evaluator.h"
+#include "log.h"
+#include <climits>
+
+/**
+ * @brief Construct a new Evaluator:: Evaluator object
+ * @details The tablebase of the target is only used if it was already built, building one takes far longer than a round.
+ *
+ * @param b The snapshot of the board of the round
+ * @param targetCell The cell to reach
+ * @param targetRobot The robot that has to reach the cell, or -1 if any robot can reach it
+ * @param directory The directory the tablebases are saved in
+ */
+Evaluator::Evaluator(shared_ptr<const BoardSnapshot> b, int targetCell, int targetRobot, const string& directory) : solver(b){
+    this->board = b;
+    this->targetCell = targetCell;
+    this->targetRobot = targetRobot;
+    this->backwardReady = false;
+    this->roundLowerBound = 0;
+    shared_ptr<Tablebase> tablebase = make_shared<Tablebase>(b, targetCell, targetRobot);
+    if(tablebase->open(tablebase->getPath(directory))){
+        log(LogLevel::DEBUG, "Evaluating the moves with the tablebase of the target");
+        this->tablebase = tablebase;
+    }
+}
+
+/**
+ * @brief The useRoundSearch function takes the searches that solved the round, from the start of the round
+ * @details The backward search is copied if it is of the same target. The solver is kept for the depths of its forward search.
+ *
+ * @param search The solver of the round (see AnytimeSolver::getExactSolver)
+ * @param lowerBound The fewest moves the round was proven to need
+ */
+void Evaluator::useRoundSearch(shared_ptr<const BidirectionalSolver> search, int lowerBound){
+    if(search == nullptr || !this->solver.copyBackward(*search, this->targetCell, this->targetRobot)){
+        return;
+    }
+    this->backwardReady = true;
+    this->roundSearch = search;
+    this->roundLowerBound = lowerBound;
+}
+
+/**
+ * @brief The isGoal function checks if a state solves the round
+ *
+ * @param state
+ * @return true
+ * @return false
+ */
+bool Evaluator::isGoal(State state) const{
+    for(int i = 0; i < ROBOT_COUNT; i++){
+        if((this->targetRobot == -1 || this->targetRobot == i) && Solver::getRobotCell(state, i) == this->targetCell){
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief The learn function records the distance of every position of an optimal solution
+ * @details The rest of an optimal solution is an optimal solution of the position it starts from, so the position after k of n moves is at n - k moves of the target.
+ *
+ * @param start The position the solution starts from
+ * @param solution An optimal solution, ignored if not solved
+ */
+void Evaluator::learn(State start, const Solution& solution){
+    if(!solution.solved){
+        return;
+    }
+    const string directions = "NESW";
+    RobotState robots(start);
+    int left = solution.moves.size();
+    this->distances[robots.getState()] = left;
+    for(const Move& move : solution.moves){
+        robots.move(move.robot, this->board->slide(robots, move.robot, directions.find(move.direction)));
+        this->distances[robots.getState()] = --left;
+    }
+}
+
+/**
+ * @brief The evaluate function gives the fewest moves left to solve the round from a position
+ *
+ * @param state The position reached
+ * @return Evaluation, exact unless the search ran out of time
+ */
+Evaluation Evaluator::evaluate(State state){
+    if(this->isGoal(state)){
+        return {0, true};
+    }
+    if(this->tablebase){
+        int distance = this->tablebase->getDistance(state);
+        if(distance >= 0){
+            return {distance, true};
+        }
+        // Left unknown by the tablebase: deeper than it, or unsolvable, the search below tells which
+    }
+    auto known = this->distances.find(state);
+    if(known != this->distances.end()){
+        return {known->second, true};
+    }
+
+    if(!this->backwardReady){
+        this->solver.setStop(stop_token(), chrono::steady_clock::time_point::max());
+        this->backwardReady = this->solver.searchBackward(this->targetCell, this->targetRobot);
+    }
+    // A position within the backward search is answered before the forward search starts
+    this->solver.setStop(stop_token(), chrono::steady_clock::now() + chrono::microseconds(EVALUATOR_MICROSECONDS));
+    Solution solution = this->solver.solve(state, this->targetCell, this->targetRobot);
+    if(solution.solved){
+        this->learn(state, solution);
+        return {(int)solution.moves.size(), true};
+    }
+    int& lowerBound = this->lowerBounds[state];
+    lowerBound = max(lowerBound, this->solver.getLowerBound());
+    if(this->roundSearch && this->roundLowerBound != INT_MAX){
+        int depth = this->roundSearch->getForwardDepth(state);
+        if(depth != -1){
+            lowerBound = max(lowerBound, this->roundLowerBound - depth);
+        }
+    }
+    return {lowerBound, lowerBound == INT_MAX};
+}
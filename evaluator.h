@@ -0,0 +1,65 @@
+/**
+ * @file evaluator.h
+ * @author Bastien
+ * @brief Class for the evaluation of the positions reached during a demonstration
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+#ifndef EVALUATOR_H
+#define EVALUATOR_H
+
+#include "bidirectional.h"
+#include "tablebase.h"
+#include <string>
+#include <unordered_map>
+
+/**
+ * The time an evaluation may spend searching forwards, in microseconds, so that a move is evaluated within a millisecond.
+ */
+const int EVALUATOR_MICROSECONDS = 800;
+
+/**
+ * @brief The Evaluation struct is the number of moves left to solve the round from a position
+ * @details When the distance is not exact, it is the best lower bound known. It is INT_MAX if the target cannot be reached anymore.
+ */
+struct Evaluation{
+    int distance;
+    bool exact;
+};
+
+/**
+ * @brief The Evaluator class gives the fewest moves left to solve the round after each move of a demonstration.
+ * @details It looks the distances up in what is already known of the round instead of solving each position again:
+ * - a tablebase of the target already on disk (see Tablebase) answers with a single read;
+ * - every position on an optimal solution is at a known distance, the rest of that solution, so a player following the optimal solution of the round (see learn) or of an earlier evaluation is answered from memory;
+ * - the backward search of the round (see useRoundSearch) holds every position a few moves from the target, with its exact distance. A position out of it is searched forwards until it meets it, for at most EVALUATOR_MICROSECONDS;
+ * - the forward search of the round gives the fewest moves from the start of the round to the positions it reached. The round needs at least its proven lower bound, so such a position is at least that bound minus its depth away from the target.
+ * Without the searches of the round, the backward search is run once, on the first evaluation. An evaluator is tied to one snapshot and one target, a new one is made for each round. It is not thread safe.
+ */
+class Evaluator{
+    private:
+        shared_ptr<const BoardSnapshot> board;
+        int targetCell;
+        int targetRobot;
+        shared_ptr<Tablebase> tablebase;
+        BidirectionalSolver solver;
+        bool backwardReady;
+        shared_ptr<const BidirectionalSolver> roundSearch;
+        int roundLowerBound;
+        unordered_map<State, int> distances;
+        unordered_map<State, int> lowerBounds;
+
+        bool isGoal(State state) const;
+
+    public:
+        Evaluator(shared_ptr<const BoardSnapshot> b, int targetCell, int targetRobot, const string& directory = TABLEBASE_DIRECTORY);
+        void useRoundSearch(shared_ptr<const BidirectionalSolver> search, int lowerBound);
+        void learn(State start, const Solution& solution);
+        Evaluation evaluate(State state);
+};
+
+#endif // EVALUATOR_H
@@ -0,0 +1,731 @@
+/**
+ * @file external.cpp
+ * @author Bastien
+ * @brief Class for the external memory solver (Implementation File)
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+#include "external.h"
+#include "symmetry.h"
+#include "log.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <queue>
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/**
+ * The first bytes of a checkpoint file, followed by the version of the format.
+ */
+const char EXTERNAL_MAGIC[4] = {'R', 'R', 'X', 'B'};
+const uint32_t EXTERNAL_VERSION = 1;
+
+/**
+ * @brief The checkpoint of a search: what it solves and the last level written.
+ */
+struct ExternalCheckpoint{
+    char magic[4];
+    uint32_t version;
+    uint32_t cells;
+    int32_t targetCell;
+    int32_t targetRobot;
+    int32_t depth;
+    uint64_t hash;
+    uint64_t start;
+    uint64_t goal;
+    int64_t nodes;
+};
+
+/**
+ * @brief The StateReader class reads the states of a file one block at a time.
+ */
+class StateReader{
+    private:
+        FILE* file;
+        vector<State> block;
+        size_t position;
+
+    public:
+        StateReader(const string& path, size_t blockSize) : position(0){
+            this->file = fopen(path.c_str(), "rb");
+            this->block.reserve(blockSize);
+        }
+        ~StateReader(){
+            if(this->file != nullptr){
+                fclose(this->file);
+            }
+        }
+        bool isOpen() const{
+            return this->file != nullptr;
+        }
+        /**
+         * @brief The next function reads the next state of the file
+         *
+         * @param state
+         * @return false at the end of the file
+         */
+        bool next(State& state){
+            if(this->position == this->block.size()){
+                if(this->file == nullptr){
+                    return false;
+                }
+                this->block.resize(this->block.capacity());
+                this->block.resize(fread(this->block.data(), sizeof(State), this->block.size(), this->file));
+                this->position = 0;
+                if(this->block.empty()){
+                    return false;
+                }
+            }
+            state = this->block[this->position++];
+            return true;
+        }
+};
+
+/**
+ * @brief The StateWriter class writes states to a file one block at a time.
+ */
+class StateWriter{
+    private:
+        FILE* file;
+        vector<State> block;
+        bool failed;
+
+    public:
+        StateWriter(const string& path, size_t blockSize) : failed(false){
+            this->file = fopen(path.c_str(), "wb");
+            this->failed = this->file == nullptr;
+            this->block.reserve(blockSize);
+        }
+        ~StateWriter(){
+            this->close();
+        }
+        void add(State state){
+            this->block.push_back(state);
+            if(this->block.size() == this->block.capacity()){
+                this->flush();
+            }
+        }
+        void flush(){
+            if(this->file != nullptr && !this->block.empty() && fwrite(this->block.data(), sizeof(State), this->block.size(), this->file) != this->block.size()){
+                this->failed = true;
+            }
+            this->block.clear();
+        }
+        /**
+         * @brief The close function writes the last block and closes the file
+         *
+         * @return true if every state was written
+         */
+        bool close(){
+            if(this->file != nullptr){
+                this->flush();
+                if(fclose(this->file) != 0){
+                    this->failed = true;
+                }
+                this->file = nullptr;
+            }
+            return !this->failed;
+        }
+};
+
+/**
+ * @brief Construct a new ExternalSolver:: ExternalSolver object
+ *
+ * @param b The board to solve, only its snapshot is kept
+ * @param directory The directory the searches keep their level, run and checkpoint files in, one directory each
+ * @param memoryLimit The number of bytes of states kept in memory
+ */
+ExternalSolver::ExternalSolver(Board* b, const string& directory, size_t memoryLimit) : ExternalSolver(b->getSnapshot(), directory, memoryLimit){
+}
+
+/**
+ * @brief Construct a new ExternalSolver:: ExternalSolver object
+ *
+ * @param b The snapshot of the board to solve
+ * @param directory The directory the searches keep their level, run and checkpoint files in, one directory each
+ * @param memoryLimit The number of bytes of states kept in memory
+ */
+ExternalSolver::ExternalSolver(shared_ptr<const BoardSnapshot> b, const string& directory, size_t memoryLimit){
+    this->board = b;
+    this->directory = directory;
+    this->complete = false;
+    this->lockFile = -1;
+    this->setMemoryLimit(memoryLimit);
+}
+
+/**
+ * @brief The getMemoryLimit function returns the number of bytes of states the solver keeps in memory
+ *
+ * @return size_t
+ */
+size_t ExternalSolver::getMemoryLimit() const{
+    return this->memoryLimit;
+}
+
+/**
+ * @brief The setMemoryLimit function sets the number of bytes of states the solver keeps in memory
+ * @details The limit covers the buffer of new states and the blocks of the files being read, it is raised to a few blocks if it is smaller. The more memory, the fewer runs to merge.
+ *
+ * @param bytes
+ */
+void ExternalSolver::setMemoryLimit(size_t bytes){
+    this->memoryLimit = max(bytes, 4 * EXTERNAL_BLOCK_SIZE * sizeof(State));
+}
+
+/**
+ * @brief The isComplete function tells if the last solve ran to the end
+ * @details A solve that could not write its files returns an unsolved solution without proving that the round cannot be solved.
+ *
+ * @return true if the last solve found the optimal solution or proved there is none
+ * @return false
+ */
+bool ExternalSolver::isComplete() const{
+    return this->complete;
+}
+
+/**
+ * @brief The getSearchDirectory function returns the directory of the files of a search, named after the hash of the board, the canonical start state and the target
+ *
+ * @param start The canonical start state of the search
+ * @param targetCell The cell to reach
+ * @param targetRobot The robot that has to reach the cell, or -1 if any robot can reach it
+ * @return string
+ */
+string ExternalSolver::getSearchDirectory(State start, int targetCell, int targetRobot) const{
+    char name[64];
+    snprintf(name, sizeof(name), "%016llx-%llx-%d-%s", (unsigned long long)this->board->getHash(), (unsigned long long)start, targetCell, targetRobot == -1 ? "m" : to_string(targetRobot).c_str());
+    return this->directory + "/" + name;
+}
+
+/**
+ * @brief The getLevelPath function returns the path of the file of a level
+ *
+ * @param depth
+ * @return string
+ */
+string ExternalSolver::getLevelPath(int depth) const{
+    return this->searchDirectory + "/level-" + to_string(depth) + ".states";
+}
+
+/**
+ * @brief The getRunPath function returns the path of a sorted run of the level being built
+ *
+ * @param run
+ * @return string
+ */
+string ExternalSolver::getRunPath(int run) const{
+    return this->searchDirectory + "/run-" + to_string(run) + ".states";
+}
+
+/**
+ * @brief The getCheckpointPath function returns the path of the checkpoint file
+ *
+ * @return string
+ */
+string ExternalSolver::getCheckpointPath() const{
+    return this->searchDirectory + "/checkpoint";
+}
+
+/**
+ * @brief The lockSearch function waits for the other searches of the same round to be over and takes the lock of the search
+ * @details The lock file is removed by the search that holds it, just before it lets it go. A search that was waiting then holds the lock of a removed file, so it opens the file again until the file it locked is the one at the path.
+ *
+ * @return true if the lock is held
+ */
+bool ExternalSolver::lockSearch(){
+    string path = this->searchDirectory + ".lock";
+    error_code error;
+    filesystem::create_directories(this->directory, error);
+    while(true){
+        this->lockFile = ::open(path.c_str(), O_RDWR | O_CREAT, 0644);
+        if(this->lockFile == -1){
+            return false;
+        }
+        struct stat locked;
+        struct stat current;
+        if(flock(this->lockFile, LOCK_EX) != 0 || fstat(this->lockFile, &locked) != 0){
+            close(this->lockFile);
+            this->lockFile = -1;
+            return false;
+        }
+        if(stat(path.c_str(), &current) == 0 && current.st_dev == locked.st_dev && current.st_ino == locked.st_ino){
+            return true;
+        }
+        close(this->lockFile);
+    }
+}
+
+/**
+ * @brief The unlockSearch function removes the lock file of the search and lets the lock go
+ *
+ */
+void ExternalSolver::unlockSearch(){
+    if(this->lockFile == -1){
+        return;
+    }
+    unlink((this->searchDirectory + ".lock").c_str());
+    close(this->lockFile);
+    this->lockFile = -1;
+}
+
+/**
+ * @brief The solve function computes the optimal solution of a round
+ * @details Same goal as Solver::solve: the robot matching the color of the objective tile has to reach it, or any robot if the objective tile is multicolored.
+ *
+ * @param robots The robots of the game
+ * @param objectiveTile The objective tile
+ * @return Solution
+ */
+Solution ExternalSolver::solve(Robot* robots[ROBOT_COUNT], Tile* objectiveTile){
+    int cells[ROBOT_COUNT];
+    int targetRobot = -1;
+    for(int i = 0; i < ROBOT_COUNT; i++){
+        cells[i] = robots[i]->getCell();
+        if(robots[i]->getColor() == objectiveTile->getTargetColor()){
+            targetRobot = i;
+        }
+    }
+    int targetCell = robots[0]->getBoard()->getCell(objectiveTile);
+    return this->solve(Solver::packState(cells), targetCell, targetRobot);
+}
+
+/**
+ * @brief The solve function runs a level by level breadth-first search from a start state, keeping the levels on disk
+ * @details The search waits for the other searches of the same round (see lockSearch), then goes on from the checkpoint of its directory if one was left by the same search.
+ *
+ * @param start The start state
+ * @param targetCell The cell to reach
+ * @param targetRobot The robot that has to reach the cell, or -1 if any robot can reach it
+ * @return Solution
+ */
+Solution ExternalSolver::solve(State start, int targetCell, int targetRobot){
+    Solution solution;
+    solution.solved = false;
+    solution.nodes = 0;
+    this->complete = false;
+
+    for(int i = 0; i < ROBOT_COUNT; i++){
+        if((targetRobot == -1 || targetRobot == i) && Solver::getRobotCell(start, i) == targetCell){
+            solution.solved = true;
+            this->complete = true;
+            return solution;
+        }
+    }
+    // The search runs on canonical states, the swappable robots being sorted
+    Symmetry symmetry(*this->board, targetRobot);
+    State real = start;
+    start = symmetry.canonical(start);
+    this->searchDirectory = this->getSearchDirectory(start, targetCell, targetRobot);
+    if(!this->lockSearch()){
+        log(LogLevel::ERROR, "External solver could not lock " + this->searchDirectory);
+        return solution;
+    }
+    solution = this->search(start, real, symmetry, targetCell, targetRobot);
+    this->unlockSearch();
+    return solution;
+}
+
+/**
+ * @brief The search function runs the search of solve, once it holds the lock of the search
+ *
+ * @param start The canonical start state
+ * @param real The start state, for the moves of the solution
+ * @param symmetry
+ * @param targetCell The cell to reach
+ * @param targetRobot The robot that has to reach the cell, or -1 if any robot can reach it
+ * @return Solution
+ */
+Solution ExternalSolver::search(State start, State real, const Symmetry& symmetry, int targetCell, int targetRobot){
+    Solution solution;
+    solution.solved = false;
+    solution.nodes = 0;
+
+    int depth = 0;
+    State goal = 0;
+    bool found = false;
+    long long size = 1;
+    if(this->loadCheckpoint(start, targetCell, targetRobot, depth, solution.nodes, goal)){
+        found = goal != 0;
+        error_code sizeError;
+        size = filesystem::file_size(this->getLevelPath(depth), sizeError) / sizeof(State);
+        log(LogLevel::INFO, "External solver resumes at level " + to_string(depth) + " after " + to_string(solution.nodes) + " nodes");
+    }else{
+        this->removeFiles();
+        error_code error;
+        filesystem::create_directories(this->searchDirectory, error);
+        if(error){
+            log(LogLevel::ERROR, "Could not create the directory " + this->searchDirectory);
+            return solution;
+        }
+        StateWriter writer(this->getLevelPath(0), 1);
+        writer.add(start);
+        if(!writer.close() || !this->saveCheckpoint(start, targetCell, targetRobot, 0, 0, 0)){
+            log(LogLevel::ERROR, "External solver could not write to " + this->searchDirectory);
+            return solution;
+        }
+    }
+
+    size_t capacity = this->memoryLimit / sizeof(State) - EXTERNAL_BLOCK_SIZE;
+    while(!found && size > 0){
+        // Expand the last level into sorted runs
+        vector<State> buffer;
+        buffer.reserve(min(capacity, (size_t)size * MOVE_COUNT + EXPAND_BATCH_SIZE * MOVE_COUNT));
+        int runCount = 0;
+        bool failed = false;
+        StateReader reader(this->getLevelPath(depth), EXTERNAL_BLOCK_SIZE);
+        State states[EXPAND_BATCH_SIZE];
+        State successors[EXPAND_BATCH_SIZE * MOVE_COUNT];
+        for(;;){
+            int count = 0;
+            while(count < EXPAND_BATCH_SIZE && reader.next(states[count])){
+                count++;
+            }
+            if(count == 0){
+                break;
+            }
+            this->board->expand(states, count, successors);
+            solution.nodes += count;
+            for(int j = 0; j < count * MOVE_COUNT; j++){
+                if(successors[j] != states[j / MOVE_COUNT]){
+                    buffer.push_back(symmetry.canonical(successors[j]));
+                }
+            }
+            if(buffer.size() + EXPAND_BATCH_SIZE * MOVE_COUNT > capacity){
+                failed |= !this->writeRun(buffer, runCount++);
+            }
+        }
+        if(!buffer.empty()){
+            failed |= !this->writeRun(buffer, runCount++);
+        }
+        vector<State>().swap(buffer);
+
+        // Merge the runs into the next level, without the states of the earlier levels
+        if(failed || !this->mergeLevel(depth + 1, runCount, targetCell, targetRobot, size, goal)){
+            log(LogLevel::ERROR, "External solver could not write to " + this->searchDirectory);
+            return solution;
+        }
+        depth++;
+        found = goal != 0;
+        this->saveCheckpoint(start, targetCell, targetRobot, depth, solution.nodes, goal);
+        log(LogLevel::DEBUG, "External solver level " + to_string(depth) + ": " + to_string(size) + " states in " + to_string(runCount) + " runs");
+    }
+
+    if(!found){
+        log(LogLevel::DEBUG, "External solver found no solution after " + to_string(solution.nodes) + " nodes");
+        this->removeFiles();
+        this->complete = true;
+        return solution;
+    }
+
+    // Walk back one level at a time, the goal being in the last one
+    State child = goal;
+    for(int level = depth - 1; level >= 0; level--){
+        State parent;
+        unsigned char move;
+        if(!this->findParent(level, symmetry, child, parent, move)){
+            log(LogLevel::ERROR, "External solver lost the path of its solution");
+            return solution;
+        }
+        solution.moves.push_back({move / 4, Solver::directionToChar(move % 4)});
+        child = parent;
+    }
+    reverse(solution.moves.begin(), solution.moves.end());
+    solution.moves = symmetry.mapMoves(*this->board, real, solution.moves);
+    solution.solved = true;
+    this->complete = true;
+    this->removeFiles();
+    log(LogLevel::DEBUG, "External solver found a solution in " + to_string(solution.moves.size()) + " moves after " + to_string(solution.nodes) + " nodes");
+    return solution;
+}
+
+/**
+ * @brief The writeRun function sorts a buffer of states, removes its duplicates and writes it as a run file
+ * @details The buffer is left empty.
+ *
+ * @param states
+ * @param run The number of the run
+ * @return true if the run was written
+ */
+bool ExternalSolver::writeRun(vector<State>& states, int run){
+    sort(states.begin(), states.end());
+    states.erase(unique(states.begin(), states.end()), states.end());
+    FILE* file = fopen(this->getRunPath(run).c_str(), "wb");
+    bool written = file != nullptr && fwrite(states.data(), sizeof(State), states.size(), file) == states.size();
+    if(file != nullptr && fclose(file) != 0){
+        written = false;
+    }
+    states.clear();
+    return written;
+}
+
+/**
+ * @brief The mergeLevel function merges the runs into the file of a new level, keeping only the states of no earlier level
+ * @details At most EXTERNAL_MAX_FILES files are read at once, fewer if the memory limit cannot hold a block of each. Until the runs and the earlier levels fit in one merge, the runs are merged that many at a time into longer runs, and once a single run is left, the states of the earliest levels are dropped from it a few levels at a time.
+ *
+ * @param depth The new level
+ * @param runCount The number of runs
+ * @param targetCell The cell to reach
+ * @param targetRobot The robot that has to reach the cell, or -1 if any robot can reach it
+ * @param size The number of states of the new level
+ * @param goal The smallest goal state of the new level, or 0 if there is none
+ * @return true if the level was written
+ */
+bool ExternalSolver::mergeLevel(int depth, int runCount, int targetCell, int targetRobot, long long& size, State& goal){
+    size_t fanIn = max((size_t)2, min(EXTERNAL_MAX_FILES, this->memoryLimit / sizeof(State) / EXTERNAL_MIN_BLOCK_SIZE - 1));
+    vector<int> runs;
+    for(int i = 0; i < runCount; i++){
+        runs.push_back(i);
+    }
+    vector<int> levels;
+    for(int i = 0; i < depth; i++){
+        levels.push_back(i);
+    }
+    int next = runCount;
+    while(!runs.empty() && runs.size() + levels.size() > fanIn){
+        vector<int> merged;
+        if(runs.size() > 1){
+            for(size_t i = 0; i < runs.size(); i += fanIn){
+                vector<int> group(runs.begin() + i, runs.begin() + min(runs.size(), i + fanIn));
+                if(!this->mergeRuns(group, vector<int>(), this->getRunPath(next), targetCell, targetRobot, size, goal)){
+                    return false;
+                }
+                merged.push_back(next++);
+            }
+        }else{
+            vector<int> earliest(levels.begin(), levels.begin() + fanIn - 1);
+            if(!this->mergeRuns(runs, earliest, this->getRunPath(next), targetCell, targetRobot, size, goal)){
+                return false;
+            }
+            merged.push_back(next++);
+            levels.erase(levels.begin(), levels.begin() + fanIn - 1);
+        }
+        runs = merged;
+    }
+    return this->mergeRuns(runs, levels, this->getLevelPath(depth), targetCell, targetRobot, size, goal);
+}
+
+/**
+ * @brief The mergeRuns function merges runs into one sorted file, without duplicates, keeping only the states of none of some earlier levels
+ * @details All the files are sorted, so one pass reads each of them once: the runs through a heap, and each earlier level with a cursor that only moves forward. The runs are removed afterwards.
+ *
+ * @param runs The numbers of the runs to merge
+ * @param levels The earlier levels to check the states against
+ * @param path The file to write
+ * @param targetCell The cell to reach
+ * @param targetRobot The robot that has to reach the cell, or -1 if any robot can reach it
+ * @param size The number of states written
+ * @param goal The smallest goal state written, or 0 if there is none
+ * @return true if the file was written
+ */
+bool ExternalSolver::mergeRuns(const vector<int>& runs, const vector<int>& levels, const string& path, int targetCell, int targetRobot, long long& size, State& goal){
+    size_t blockSize = max(EXTERNAL_MIN_BLOCK_SIZE, min(EXTERNAL_BLOCK_SIZE, this->memoryLimit / sizeof(State) / (runs.size() + levels.size() + 1)));
+    vector<unique_ptr<StateReader>> runReaders;
+    vector<unique_ptr<StateReader>> levelReaders;
+    for(int run : runs){
+        runReaders.emplace_back(new StateReader(this->getRunPath(run), blockSize));
+        if(!runReaders.back()->isOpen()){
+            return false;
+        }
+    }
+    // Without runs there is nothing to check against the levels
+    int levelCount = runs.empty() ? 0 : levels.size();
+    vector<State> cursors(levelCount);
+    vector<bool> ended(levelCount, false);
+    for(int i = 0; i < levelCount; i++){
+        levelReaders.emplace_back(new StateReader(this->getLevelPath(levels[i]), blockSize));
+        if(!levelReaders.back()->isOpen()){
+            return false;
+        }
+        ended[i] = !levelReaders[i]->next(cursors[i]);
+    }
+
+    typedef pair<State, int> Head;
+    priority_queue<Head, vector<Head>, greater<Head>> heads;
+    for(int i = 0; i < runReaders.size(); i++){
+        State state;
+        if(runReaders[i]->next(state)){
+            heads.push(make_pair(state, i));
+        }
+    }
+
+    StateWriter writer(path, blockSize);
+    size = 0;
+    goal = 0;
+    bool hasLast = false;
+    State last = 0;
+    while(!heads.empty()){
+        Head head = heads.top();
+        heads.pop();
+        State state;
+        if(runReaders[head.second]->next(state)){
+            heads.push(make_pair(state, head.second));
+        }
+        if(hasLast && head.first == last){
+            continue;
+        }
+        hasLast = true;
+        last = head.first;
+        bool seen = false;
+        for(int i = 0; i < levelCount && !seen; i++){
+            while(!ended[i] && cursors[i] < last){
+                ended[i] = !levelReaders[i]->next(cursors[i]);
+            }
+            seen = !ended[i] && cursors[i] == last;
+        }
+        if(seen){
+            continue;
+        }
+        writer.add(last);
+        size++;
+        if(goal == 0){
+            for(int i = 0; i < ROBOT_COUNT; i++){
+                if((targetRobot == -1 || targetRobot == i) && Solver::getRobotCell(last, i) == targetCell){
+                    goal = last;
+                    break;
+                }
+            }
+        }
+    }
+    runReaders.clear();
+    for(int run : runs){
+        remove(this->getRunPath(run).c_str());
+    }
+    return writer.close();
+}
+
+/**
+ * @brief The findParent function finds the smallest state of a level, and its smallest move, leading to a state
+ * @details The level is read in order, so the first state leading to the child is the smallest one. Like ParallelSolver::findParent, only the states with exactly one robot off the cells of the child are slid.
+ *
+ * @param depth The level before the child
+ * @param symmetry The symmetry the states of the search were put in canonical form with
+ * @param child
+ * @param parent The parent found
+ * @param move The move found (robot * 4 + direction)
+ * @return true if a parent was found
+ * @return false
+ */
+bool ExternalSolver::findParent(int depth, const Symmetry& symmetry, State child, State& parent, unsigned char& move){
+    RobotState childRobots(child);
+    StateReader reader(this->getLevelPath(depth), EXTERNAL_BLOCK_SIZE);
+    State state;
+    while(reader.next(state)){
+        int robot = -1;
+        int moved = 0;
+        for(int r = 0; r < ROBOT_COUNT && moved < 2; r++){
+            if(childRobots.robotAt(Solver::getRobotCell(state, r)) == -1){
+                robot = r;
+                moved++;
+            }
+        }
+        if(moved != 1){
+            continue;
+        }
+        for(int direction = 0; direction < 4; direction++){
+            int to = this->board->slide(RobotState(state), robot, direction);
+            if(symmetry.canonical(Solver::setRobotCell(state, robot, to)) == child){
+                parent = state;
+                move = robot * 4 + direction;
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief The loadCheckpoint function reads the checkpoint of the search
+ *
+ * @param start The canonical start state of the search
+ * @param targetCell The cell to reach
+ * @param targetRobot The robot that has to reach the cell, or -1 if any robot can reach it
+ * @param depth The last level written
+ * @param nodes The number of nodes expanded so far
+ * @param goal The goal state found in the last level, or 0
+ * @return true if the checkpoint was left by the same search on the same board
+ * @return false
+ */
+bool ExternalSolver::loadCheckpoint(State start, int targetCell, int targetRobot, int& depth, long long& nodes, State& goal){
+    FILE* file = fopen(this->getCheckpointPath().c_str(), "rb");
+    if(file == nullptr){
+        return false;
+    }
+    ExternalCheckpoint checkpoint;
+    bool read = fread(&checkpoint, sizeof(checkpoint), 1, file) == 1;
+    fclose(file);
+    if(!read || memcmp(checkpoint.magic, EXTERNAL_MAGIC, 4) != 0 || checkpoint.version != EXTERNAL_VERSION || checkpoint.cells != CELL_COUNT || checkpoint.hash != this->board->getHash() || checkpoint.start != start || checkpoint.targetCell != targetCell || checkpoint.targetRobot != targetRobot){
+        return false;
+    }
+    for(int i = 0; i <= checkpoint.depth; i++){
+        if(!filesystem::exists(this->getLevelPath(i))){
+            log(LogLevel::WARNING, "External solver checkpoint is missing level " + to_string(i));
+            return false;
+        }
+    }
+    depth = checkpoint.depth;
+    nodes = checkpoint.nodes;
+    goal = checkpoint.goal;
+    return true;
+}
+
+/**
+ * @brief The saveCheckpoint function writes the checkpoint of the search
+ * @details The file is written next to its final name and renamed, so a search stopped midway always leaves a complete checkpoint behind.
+ *
+ * @param start The canonical start state of the search
+ * @param targetCell The cell to reach
+ * @param targetRobot The robot that has to reach the cell, or -1 if any robot can reach it
+ * @param depth The last level written
+ * @param nodes The number of nodes expanded so far
+ * @param goal The goal state found in the last level, or 0
+ * @return true if the checkpoint was written
+ */
+bool ExternalSolver::saveCheckpoint(State start, int targetCell, int targetRobot, int depth, long long nodes, State goal){
+    ExternalCheckpoint checkpoint;
+    memset(&checkpoint, 0, sizeof(checkpoint));
+    memcpy(checkpoint.magic, EXTERNAL_MAGIC, 4);
+    checkpoint.version = EXTERNAL_VERSION;
+    checkpoint.cells = CELL_COUNT;
+    checkpoint.targetCell = targetCell;
+    checkpoint.targetRobot = targetRobot;
+    checkpoint.depth = depth;
+    checkpoint.hash = this->board->getHash();
+    checkpoint.start = start;
+    checkpoint.goal = goal;
+    checkpoint.nodes = nodes;
+    string path = this->getCheckpointPath();
+    string temporary = path + ".tmp";
+    FILE* file = fopen(temporary.c_str(), "wb");
+    bool written = file != nullptr && fwrite(&checkpoint, sizeof(checkpoint), 1, file) == 1;
+    if(file != nullptr && fclose(file) != 0){
+        written = false;
+    }
+    if(!written || rename(temporary.c_str(), path.c_str()) != 0){
+        log(LogLevel::WARNING, "Could not write the checkpoint " + path);
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief The removeFiles function removes the level, run and checkpoint files of the search, then its directory if nothing else is left in it
+ *
+ */
+void ExternalSolver::removeFiles(){
+    error_code error;
+    for(const auto& entry : filesystem::directory_iterator(this->searchDirectory, error)){
+        string name = entry.path().filename().string();
+        if(name.rfind("level-", 0) == 0 || name.rfind("run-", 0) == 0 || name.rfind("checkpoint", 0) == 0){
+            filesystem::remove(entry.path(), error);
+        }
+    }
+    filesystem::remove(this->searchDirectory, error);
+}
@@ -0,0 +1,85 @@
+/**
+ * @file external.h
+ * @author Bastien
+ * @brief Class for the external memory solver
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+#ifndef EXTERNAL_H
+#define EXTERNAL_H
+
+#include "solver.h"
+#include <memory>
+#include <string>
+
+/**
+ * The directory the external memory solver keeps its searches in by default, each in a directory of its own.
+ */
+const char EXTERNAL_DIRECTORY[] = "search";
+
+/**
+ * The number of bytes of states the external memory solver keeps in memory by default.
+ */
+const size_t EXTERNAL_MEMORY_LIMIT = (size_t)256 << 20;
+
+/**
+ * The number of states read or written at a time from a file of the external memory solver.
+ */
+const size_t EXTERNAL_BLOCK_SIZE = 1 << 14;
+
+/**
+ * The fewest states read at a time from a file while merging, however low the memory limit.
+ */
+const size_t EXTERNAL_MIN_BLOCK_SIZE = 1024;
+
+/**
+ * The largest number of files the external memory solver reads at once while merging, more runs being merged in several passes.
+ */
+const size_t EXTERNAL_MAX_FILES = 64;
+
+/**
+ * @brief The ExternalSolver class computes the optimal solution of a round with a breadth-first search whose levels are kept on disk.
+ * @details Each level (number of moves) is a file of sorted canonical states (see Symmetry). The next level is built by expanding the last one into a buffer; each time the buffer reaches the memory limit it is sorted and written as a run file. The runs are then merged, a bounded number of files at a time (see mergeLevel), and every state already found in an earlier level is dropped by reading the level files alongside, so only a few blocks of each file are in memory at a time. Moves cannot always be undone (a robot moved north does not always come back with a move south), so the new states are checked against every earlier level and not only the last two.
+ * The files of a search are in a directory named after the board, the position and the target (see getSearchDirectory), so several searches can share the same directory. A checkpoint is written after each level: a solve started again with the same board, position and target goes on from the last complete level, so a long search can be stopped and resumed. The files are removed once the search is over.
+ * A search holds an exclusive lock on a file next to its directory while it runs. A second solve of the same round, from another thread or process, waits for it, then goes on from its checkpoint or starts again if the first one finished.
+ * The path is rebuilt backwards like ParallelSolver, by taking at each level the smallest state (then the smallest move) leading to the next state of the path.
+ */
+class ExternalSolver{
+    private:
+        shared_ptr<const BoardSnapshot> board;
+        string directory;
+        string searchDirectory;
+        size_t memoryLimit;
+        bool complete;
+        int lockFile;
+
+        string getSearchDirectory(State start, int targetCell, int targetRobot) const;
+        string getLevelPath(int depth) const;
+        string getRunPath(int run) const;
+        string getCheckpointPath() const;
+        bool lockSearch();
+        void unlockSearch();
+        Solution search(State start, State real, const Symmetry& symmetry, int targetCell, int targetRobot);
+        bool writeRun(vector<State>& states, int run);
+        bool mergeLevel(int depth, int runCount, int targetCell, int targetRobot, long long& size, State& goal);
+        bool mergeRuns(const vector<int>& runs, const vector<int>& levels, const string& path, int targetCell, int targetRobot, long long& size, State& goal);
+        bool findParent(int depth, const Symmetry& symmetry, State child, State& parent, unsigned char& move);
+        bool loadCheckpoint(State start, int targetCell, int targetRobot, int& depth, long long& nodes, State& goal);
+        bool saveCheckpoint(State start, int targetCell, int targetRobot, int depth, long long nodes, State goal);
+        void removeFiles();
+
+    public:
+        ExternalSolver(Board* b, const string& directory = EXTERNAL_DIRECTORY, size_t memoryLimit = EXTERNAL_MEMORY_LIMIT);
+        ExternalSolver(shared_ptr<const BoardSnapshot> b, const string& directory = EXTERNAL_DIRECTORY, size_t memoryLimit = EXTERNAL_MEMORY_LIMIT);
+        size_t getMemoryLimit() const;
+        void setMemoryLimit(size_t bytes);
+        bool isComplete() const;
+        Solution solve(Robot* robots[ROBOT_COUNT], Tile* objectiveTile);
+        Solution solve(State start, int targetCell, int targetRobot);
+};
+
+#endif // EXTERNAL_H
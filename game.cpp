@@ -12,7 +12,9 @@
 #include "game.h"
 #include "log.h"
 #include "robot.h"
+#include <climits>
 #include <random>
+#include <sstream>
 
 /**
  * @brief Construct a new Game:: Game object
@@ -21,18 +23,26 @@
  * @param p The players that will play the game
  * @param r The robots that will be used for the game
  */
-Game::Game(Board* b, vector<Player*> p, Robot* r[4]){
+Game::Game(Board* b, vector<Player*> p, Robot* r[ROBOT_COUNT]){
     this->board = b;
     for(int i = 0; i < p.size(); i++){
         this->players.push_back(p[i]);
     }
-    for(int i = 0; i < 4; i++){
+    for(int i = 0; i < ROBOT_COUNT; i++){
         this->robots[i] = r[i];
     }
     this->timer = 0;
     this->movecountgoal = 0;
     this->objectiveTile = nullptr;
     this->currentPlayer = nullptr;
+    this->solution.solved = false;
+    this->solution.nodes = 0;
+    this->solutionRevision = 0;
+    this->targetSolutionsRevision = 0;
+    this->targetSolutionsStart = 0;
+    this->pendingRevision = 0;
+    this->pendingKey = 0;
+    this->solutionLowerBound = 0;
 }
 
 /**
@@ -52,7 +62,7 @@ Board* Game::getBoard(){
 void Game::drawObjectiveTile(){
     random_device rd;
     mt19937 gen(rd());
-    uniform_int_distribution<> distr(0, 16);
+    uniform_int_distribution<> distr(0, this->board->getTargetCount() - 1);
     int n = distr(gen);
     this->objectiveTile = this->board->getTarget(n);
 }
@@ -63,17 +73,16 @@ void Game::drawObjectiveTile(){
  * 
  */
 void Game::placeRobots(){
+    this->board->removeRobots();
     //choose a random tile for each robot
-    for(int i = 0; i < 4; i++){
-        int x = rand() % 16;
-        int y = rand() % 16;
+    for(int i = 0; i < ROBOT_COUNT; i++){
+        int x = rand() % X_SIZE;
+        int y = rand() % Y_SIZE;
         //check if the tile is empty or if it is a center tile
-        if(!this->board->getTile(x,y)->checkHasRobot() && !this->board->getTile(x,y)->checkIsCentralTile()){
-            this->board->getTile(x,y)->setHasRobot(true);
-            this->board->getTile(x,y)->setRobotColor(this->robots[i]->getColor());
+        if(this->board->robotAt(y * X_SIZE + x) == -1 && !this->board->getTile(x,y)->checkIsCentralTile() && this->board->getTile(x,y)->getDeflector() == ' '){
+            this->board->placeRobot(i, y * X_SIZE + x, this->robots[i]->getColor());
             this->robots[i]->setBasePositionX(x);
             this->robots[i]->setBasePositionY(y);
-            this->robots[i]->setTile(this->board->getTile(x,y));
             //print the placed robot
             log(LogLevel::DEBUG, "Robot " + to_string(i+1) + " placed at (" + to_string(x) + ", " + to_string(y) + ") with number " + to_string(this->robots[i]->getNumber()) + " and color " + string(1, this->robots[i]->getColor()));
         }
@@ -119,10 +128,36 @@ void Game::setBoard(Board* b){
  */
 void Game::initGame(){
     log(LogLevel::INFO, "Initializing game...");
+    this->newBoard();
+    this->getInputs();
+}
+
+/**
+ * @brief The newBoard method will generate a new board and place the robots on it.
+ * @details The board is generated again in place, so no memory is allocated or leaked from one board to the next.
+ * 
+ */
+void Game::newBoard(){
+    this->stopSolving();
     this->board->initializeBoard();
+    this->objectiveTile = nullptr;
+    this->placeRobots();
+    this->board->drawBoard(this->objectiveTile);
+}
+
+/**
+ * @brief The newClassicBoard method will lay out one of the official boards of the original game and place the robots on it.
+ * 
+ * @param layout The number of the official board, from 0 to CLASSIC_BOARD_COUNT - 1
+ */
+void Game::newClassicBoard(int layout){
+    if(!this->board->assembleClassicBoard(layout)){
+        return;
+    }
+    this->stopSolving();
+    this->objectiveTile = nullptr;
     this->placeRobots();
     this->board->drawBoard(this->objectiveTile);
-    this->getInputs();
 }
 
 /**
@@ -145,6 +180,12 @@ string colorToString(char c){
         case 'Y':
             return "yellow";
             break;
+        case 'S':
+            return "silver";
+            break;
+        case 'M':
+            return "multicolor";
+            break;
         default:
             return "unknown";
             break;
@@ -153,12 +194,13 @@ string colorToString(char c){
 
 /**
  * @brief The getInputs method will get the inputs from the players to trigger the beginning of the game/round.
+ * @details This is the main loop of the game: each round runs to its end and then comes back here, until the players exit.
  * 
  */
 void Game::getInputs(){
     char input;
     while (true) {
-        log(LogLevel::INFO, "Controls: n = new round, e = exit, b = new board");
+        log(LogLevel::INFO, "Controls: n = new round, e = exit, b = new board, c = official board, d = add diagonal deflectors, w = edit walls, a = solve all targets");
         cin >> input;
         switch (input) {
             case 'n':
@@ -168,11 +210,31 @@ void Game::getInputs(){
                 break;
             case 'b':
                 log(LogLevel::INFO, "Starting new board");
-                this->board = new Board();
-                for(int i = 0; i < 4; i++){
-                    robots[i]->setBoard(board);
+                this->newBoard();
+                break;
+            case 'c':
+                log(LogLevel::INFO, "Enter the number of the official board (0 to " + to_string(CLASSIC_BOARD_COUNT - 1) + ")");
+                int layout;
+                if(cin >> layout){
+                    this->newClassicBoard(layout);
+                }else{
+                    cin.clear();
+                    cin.ignore(numeric_limits<streamsize>::max(), '\n');
+                    log(LogLevel::INFO, "Unknown input");
                 }
-                this->initGame();
+                break;
+            case 'd':
+                log(LogLevel::INFO, "Adding diagonal deflectors, robots go through the deflectors of their color and bounce off the others");
+                this->board->placeDeflectors(DEFLECTOR_COUNT);
+                this->board->drawBoard(this->objectiveTile);
+                break;
+            case 'w':
+                this->editWalls();
+                break;
+            case 'a':
+                this->resetRobotsPosition();
+                this->solveAllTargets();
+                break;
             case 'e':
                 log(LogLevel::INFO, "Exiting game");
                 return;
@@ -295,8 +357,10 @@ void Game::setMoveCount(){
 /**
  * @brief The moveRobot method will move the robot according to the input.
  * 
+ * @return true if the round is over (solved, or the player left and a new board was generated)
+ * @return false if the move count was reached and the next player has to play
  */
-void Game::moveRobot(){
+bool Game::moveRobot(){
     char input;
     int selectedRobot = 0;
     string color;
@@ -310,34 +374,38 @@ void Game::moveRobot(){
                 log(LogLevel::INFO, "Robot " + colorToString(robots[selectedRobot]->getColor()) + " moved up");
                 this->robots[selectedRobot]->moveRobot('N');
                 this->board->drawBoard(this->objectiveTile);
+                this->evaluateMove();
                 movecount++;
                 break;
             case 's':
                 log(LogLevel::INFO, "Robot " + colorToString(robots[selectedRobot]->getColor()) + " moved down");
                 this->robots[selectedRobot]->moveRobot('S');
                 this->board->drawBoard(this->objectiveTile);
+                this->evaluateMove();
                 movecount++;
                 break;
             case 'q':
                 log(LogLevel::INFO, "Robot " + colorToString(robots[selectedRobot]->getColor()) + " moved left");
                 this->robots[selectedRobot]->moveRobot('W');
                 this->board->drawBoard(this->objectiveTile);
+                this->evaluateMove();
                 movecount++;
                 break;
             case 'd':
                 log(LogLevel::INFO, "Robot " + colorToString(robots[selectedRobot]->getColor()) + " moved right");
                 this->robots[selectedRobot]->moveRobot('E');
                 this->board->drawBoard(this->objectiveTile);
+                this->evaluateMove();
                 movecount++;
                 break;
             case 'n':
-                selectedRobot = (selectedRobot + 1) % 4;
+                selectedRobot = (selectedRobot + 1) % ROBOT_COUNT;
                 color = colorToString(robots[selectedRobot]->getColor());
                 break;
             case 'e':
                 log(LogLevel::INFO, "Exiting robot movement");
-                initGame();
-                break;
+                this->newBoard();
+                return true;
             default:
                 log(LogLevel::INFO, "Unknown input");
                 cin.clear();
@@ -348,16 +416,21 @@ void Game::moveRobot(){
             continue;
         }else if(this->isRoundSolved(this->objectiveTile)){
             log(LogLevel::INFO, "Board solved");
+            if(this->solution.solved){
+                string moves;
+                for(int i = 0; i < this->solution.moves.size(); i++){
+                    moves += " " + string(1, this->robots[this->solution.moves[i].robot]->getColor()) + this->solution.moves[i].direction;
+                }
+                log(LogLevel::INFO, "The optimal solution was " + to_string(this->solution.moves.size()) + " moves:" + moves);
+            }
             this->updateScore();
-            this->getInputs();
-            break;
+            return true;
         }
         if(movecount >= this->movecountgoal){
             log(LogLevel::DEBUG, "Move count is : " + to_string(movecount) + " and move count goal is : " + to_string(this->movecountgoal));
             log(LogLevel::INFO, "Move count reached, next player with the best solution can play");
             this->resetRobotsPosition();
-            this->play();
-            break;
+            return false;
         }else{
             log(LogLevel::DEBUG, "Move count is : " + to_string(movecount) + " and move count goal is : " + to_string(this->movecountgoal));
             log(LogLevel::INFO, "Moves remaining : " + to_string(this->movecountgoal - movecount));
@@ -373,27 +446,17 @@ void Game::moveRobot(){
  * @return false 
  */
 bool Game::isRoundSolved(Tile* objectiveTile){
-    int tileX = objectiveTile->getX();
-    int tileY = objectiveTile->getY();
+    int tileX = this->board->getCell(objectiveTile) % X_SIZE;
+    int tileY = this->board->getCell(objectiveTile) / X_SIZE;
     char tileColor = objectiveTile->getTargetColor();
-    bool hasRobot = objectiveTile->checkHasRobot();
+    int robot = this->board->robotAt(tileY * X_SIZE + tileX);
     log(LogLevel::DEBUG, "Checking if round is solved");
     log(LogLevel::DEBUG, "Objective tile: " + to_string(tileX) + " " + to_string(tileY) + " " + tileColor);
-    if (hasRobot) {
-        log(LogLevel::DEBUG, "Objective tile has a robot on it, checking if it's the right one");
-        for(int i = 0; i < 4; i++){
-            log(LogLevel::DEBUG, "Robot " + to_string(i) + " position: " + to_string(this->robots[i]->getTile()->getX()) + " " + to_string(this->robots[i]->getTile()->getY()) + " " + colorToString(this->robots[i]->getColor()));
-            int robotX = this->robots[i]->getTile()->getX();
-            int robotY = this->robots[i]->getTile()->getY();
-            char robotColor = this->robots[i]->getColor();
-            if(robotX == tileX && robotY == tileY && robotColor == tileColor){
-                return true;
-            }
-            if(tileColor == 'M'){//if the objective tile is multicolor, we need to check if any robot is on it
-                if(robotX == tileX && robotY == tileY){
-                    return true;
-                }
-            }
+    if (robot != -1) {
+        log(LogLevel::DEBUG, "Objective tile has the " + colorToString(this->robots[robot]->getColor()) + " robot on it, checking if it's the right one");
+        //if the objective tile is multicolor, any robot solves the round
+        if(tileColor == 'M' || this->robots[robot]->getColor() == tileColor){
+            return true;
         }
     }
     return false;
@@ -410,16 +473,28 @@ void Game::updateScore(){
 
 /**
  * @brief The newRound method will start a new round.
+ * @details The first bid is checked against the fewest moves proven so far (see checkBid) and asked again until it can be done. A round proven unsolvable ends there.
  * 
  */
 void Game::newRound(){
     this->drawObjectiveTile();
     log(LogLevel::DEBUG, "Objective tile drawn");
+    // The players think about the round while it is solved
+    this->startSolving();
     this->board->drawBoard(this->objectiveTile);
     log(LogLevel::INFO, "Round started, each player needs to find the way to get the robot with the same color as the objective tile to the target tile in the least amount of moves");
     log(LogLevel::INFO, "When you are ready, enter the number of moves the player with the best solution thinks he can do it in, the 1min timer will start right after");
     this->setMoveCount();
-    this->startTimer(60);
+    // A bid that cannot be done is refused before the timer starts
+    while(!this->checkBid()){
+        if(this->solutionLowerBound == INT_MAX){
+            log(LogLevel::INFO, "Round over, start a new round");
+            return;
+        }
+        log(LogLevel::INFO, "Enter another number of moves");
+        this->setMoveCount();
+    }
+    this->startTimer(ROUND_SECONDS);
     char input;
     while (timerRunning) {
         cin >> input;
@@ -440,18 +515,31 @@ void Game::newRound(){
 
 /**
  * @brief The play method will start the moves of the current player.
+ * @details Players take turns, best bid first, until one of them solves the round. The search of the round is stopped first, so its best solution is there without waiting for the deadline; a bid with fewer moves than the proven lower bound is refused without a demonstration.
  * 
  */
 void Game::play(){
-    log(LogLevel::INFO, "Enter the number of the player with the best solution");
-    this->selectPlayer();
-    log(LogLevel::INFO, "Player " + to_string(this->currentPlayer->getNumber() + 1) + " selected");
-    log(LogLevel::INFO, "Enter the number of moves the player thinks he can do it in");
-    this->setMoveCount();
-    log(LogLevel::INFO, "Player " + to_string(this->currentPlayer->getNumber() + 1) + " thinks she/he can do it in " + to_string(this->movecountgoal) + " moves");
-    log(LogLevel::INFO, "The player with the best solution will now play");
-    this->board->drawBoard(this->objectiveTile);
-    this->moveRobot();
+    // The timer is over or was stopped: the search gives its best solution now rather than at its deadline
+    this->roundSolver.request_stop();
+    this->finishSolving();
+    this->startEvaluator();
+    while(true){
+        log(LogLevel::INFO, "Enter the number of the player with the best solution");
+        this->selectPlayer();
+        log(LogLevel::INFO, "Player " + to_string(this->currentPlayer->getNumber() + 1) + " selected");
+        log(LogLevel::INFO, "Enter the number of moves the player thinks he can do it in");
+        this->setMoveCount();
+        log(LogLevel::INFO, "Player " + to_string(this->currentPlayer->getNumber() + 1) + " thinks she/he can do it in " + to_string(this->movecountgoal) + " moves");
+        if(!this->checkBid()){
+            log(LogLevel::INFO, "The player with the next best solution will now play");
+            continue;
+        }
+        log(LogLevel::INFO, "The player with the best solution will now play");
+        this->board->drawBoard(this->objectiveTile);
+        if(this->moveRobot()){
+            break;
+        }
+    }
 }
 
 /**
@@ -459,10 +547,264 @@ void Game::play(){
  * 
  */
 void Game::resetRobotsPosition(){
-    for(int i = 0; i < 4; i++){
-        this->robots[i]->getTile()->setHasRobot(false);
-        this->robots[i]->setTile(this->board->getTile(this->robots[i]->getBasePositionX(), this->robots[i]->getBasePositionY()));
-        this->robots[i]->getTile()->setHasRobot(true);
+    for(int i = 0; i < ROBOT_COUNT; i++){
+        this->board->move(i, this->robots[i]->getBasePositionY() * X_SIZE + this->robots[i]->getBasePositionX());
     }
     this->board->drawBoard(this->objectiveTile);
+}
+
+/**
+ * @brief The stopSolving method will stop the search of the current round, if any, and drop its result.
+ * 
+ */
+void Game::stopSolving(){
+    // Assigning an empty thread requests a stop and joins, so the old search writes nothing after the reset
+    this->roundSolver = jthread();
+    this->pendingSolution = future<Solution>();
+    this->roundSearch = nullptr;
+    this->solutionLowerBound = 0;
+    this->evaluator = nullptr;
+}
+
+/**
+ * @brief The startSolving method will start solving the current round on a worker thread.
+ * @details The thread gets an immutable snapshot of the board and the placement of the robots packed in a state, so the players can move the robots while it runs. The anytime solver gets as long as the players (ROUND_SECONDS): on a board too hard to prove the optimal solution in time, the best solution found is kept. Each bound it proves is published in solutionLowerBound, so the bids can be checked before the search ends. If all the targets were solved from the same placement on the same board (see solveAllTargets), or if the round is in the solution cache, the solution is taken from there and no thread is started.
+ * 
+ */
+void Game::startSolving(){
+    this->stopSolving();
+
+    int cells[ROBOT_COUNT];
+    int targetRobot = -1;
+    for(int i = 0; i < ROBOT_COUNT; i++){
+        cells[i] = this->board->cellOf(i);
+        if(this->robots[i]->getColor() == this->objectiveTile->getTargetColor()){
+            targetRobot = i;
+        }
+    }
+    State start = Solver::packState(cells);
+    int targetCell = this->board->getCell(this->objectiveTile);
+    shared_ptr<const BoardSnapshot> snapshot = this->board->getSnapshot();
+    int target = snapshot->findTarget(targetCell);
+    this->pendingKey = SolutionCache::getKey(*snapshot, start, targetCell, targetRobot);
+    Solution known;
+    bool isKnown = false;
+    if(target != -1 && target < this->targetSolutions.size() && this->targetSolutionsRevision == this->board->getRevision() && this->targetSolutionsStart == start){
+        known = this->targetSolutions[target];
+        isKnown = true;
+    }else if(this->cache.find(this->pendingKey, known)){
+        log(LogLevel::DEBUG, "Solution of the round found in the cache");
+        isKnown = true;
+    }
+    if(isKnown){
+        promise<Solution> ready;
+        ready.set_value(known);
+        this->pendingSolution = ready.get_future();
+        this->pendingRevision = this->board->getRevision();
+        this->solutionLowerBound = known.solved ? (int)known.moves.size() : INT_MAX;
+        return;
+    }
+
+    promise<Solution> result;
+    this->pendingSolution = result.get_future();
+    this->pendingRevision = this->board->getRevision();
+    chrono::steady_clock::time_point deadline = chrono::steady_clock::now() + chrono::seconds(ROUND_SECONDS);
+    this->roundSolver = jthread([this, snapshot, start, targetCell, targetRobot, deadline, result = move(result)](stop_token token) mutable{
+        // The progress of the solver would be printed between the prompts while the players think
+        setThreadLogLevel(LogLevel::WARNING);
+        AnytimeSolver solver(snapshot);
+        solver.setProgress([this](int lower, int){
+            this->solutionLowerBound = lower;
+        });
+        Solution solution = solver.solve(start, targetCell, targetRobot, deadline, token);
+        this->solutionLowerBound = solver.getLowerBound();
+        this->roundSearch = solver.getExactSolver();
+        result.set_value(solution);
+    });
+    log(LogLevel::DEBUG, "Solving the round in the background");
+}
+
+/**
+ * @brief The finishSolving method will wait for the solution started by startSolving and keep it as the solution of the round.
+ * @details The wait is at most until the deadline of the search, which is the end of the timer of the round, or until a stop requested on roundSolver is seen (within a millisecond). A solution proven optimal is added to the solution cache. The solution is not printed, the players are about to bid: it is shown once the round is solved.
+ * 
+ */
+void Game::finishSolving(){
+    if(!this->pendingSolution.valid()){
+        return;
+    }
+    this->solution = this->pendingSolution.get();
+    this->solutionRevision = this->pendingRevision;
+    // Only a solution proven optimal, or a round proven unsolvable, is kept for the next runs
+    int lowerBound = this->solutionLowerBound;
+    if(this->solution.solved ? this->solution.moves.size() == lowerBound : lowerBound == INT_MAX){
+        this->cache.insert(this->pendingKey, this->solution);
+    }
+    log(LogLevel::DEBUG, "Solution cache: " + to_string(this->cache.getHits()) + " hits, " + to_string(this->cache.getMisses()) + " misses, " + to_string(this->cache.getEvictions()) + " evictions");
+}
+
+/**
+ * @brief The checkBid method will check the current bid against the fewest moves the round is proven to need.
+ * @details The bound is solutionLowerBound, raised by the search running in the background as it proves each depth, so a bid that cannot be done is flagged as soon as it is made instead of after a failed demonstration. A bid under a bound not proven yet is accepted. The players are told why a bid is refused. newRound asks for the first bid again until it passes, and play hands a refused bid over to the next player.
+ * 
+ * @return true if the bid is at least the bound proven so far
+ * @return false if no solution has that few moves, or the round cannot be solved
+ */
+bool Game::checkBid(){
+    int lowerBound = this->solutionLowerBound;
+    if(this->movecountgoal >= lowerBound){
+        return true;
+    }
+    if(lowerBound == INT_MAX){
+        log(LogLevel::INFO, "This round cannot be solved, whatever the bid");
+    }else{
+        log(LogLevel::INFO, "A bid of " + to_string(this->movecountgoal) + " moves is too optimistic: this round needs at least " + to_string(lowerBound) + " moves");
+    }
+    return false;
+}
+
+/**
+ * @brief The startEvaluator method will prepare the evaluation of the moves of the demonstrations of the current round.
+ * @details The robots are on their starting cells. If the solution of the round is proven optimal, the evaluator learns it, so every move along it is evaluated without a search. If the round was searched in the background on the same board, the evaluator looks the other moves up in that search.
+ * 
+ */
+void Game::startEvaluator(){
+    int cells[ROBOT_COUNT];
+    int targetRobot = -1;
+    for(int i = 0; i < ROBOT_COUNT; i++){
+        cells[i] = this->board->cellOf(i);
+        if(this->robots[i]->getColor() == this->objectiveTile->getTargetColor()){
+            targetRobot = i;
+        }
+    }
+    this->evaluator = make_unique<Evaluator>(this->board->getSnapshot(), this->board->getCell(this->objectiveTile), targetRobot);
+    if(this->solution.solved && this->solution.moves.size() == this->solutionLowerBound){
+        this->evaluator->learn(Solver::packState(cells), this->solution);
+    }
+    if(this->solutionRevision == this->board->getRevision()){
+        this->evaluator->useRoundSearch(this->roundSearch, this->solutionLowerBound);
+    }
+}
+
+/**
+ * @brief The evaluateMove method will tell the player how many moves are left to solve the round from the position just reached.
+ * 
+ */
+void Game::evaluateMove(){
+    if(this->evaluator == nullptr){
+        return;
+    }
+    int cells[ROBOT_COUNT];
+    for(int i = 0; i < ROBOT_COUNT; i++){
+        cells[i] = this->board->cellOf(i);
+    }
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    // Only the answer is printed, not the progress of the search
+    LogLevel level = threadLogLevel;
+    setThreadLogLevel(LogLevel::WARNING);
+    Evaluation evaluation = this->evaluator->evaluate(Solver::packState(cells));
+    setThreadLogLevel(level);
+    log(LogLevel::DEBUG, "Move evaluated in " + to_string(chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start).count()) + " microseconds");
+    if(evaluation.distance == INT_MAX){
+        log(LogLevel::INFO, "The target cannot be reached anymore from here");
+    }else if(evaluation.exact){
+        log(LogLevel::INFO, "Optimal moves left from here: " + to_string(evaluation.distance));
+    }else{
+        log(LogLevel::INFO, "At least " + to_string(evaluation.distance) + " moves left from here");
+    }
+}
+
+/**
+ * @brief The solveRound method will compute the optimal solution of the current round.
+ * @details Same as startSolving, waiting for the answer.
+ * 
+ */
+void Game::solveRound(){
+    this->startSolving();
+    this->finishSolving();
+}
+
+/**
+ * @brief The getSolution method will return the optimal solution of the current round.
+ * @details Waits for the search started by startSolving if it is still running. If the walls of the board changed since the solution was computed, the round is solved again first.
+ * 
+ * @return Solution 
+ */
+Solution Game::getSolution(){
+    this->finishSolving();
+    if(this->objectiveTile != nullptr && this->solutionRevision != this->board->getRevision()){
+        log(LogLevel::DEBUG, "The board changed, solving the round again");
+        this->solveRound();
+    }
+    return this->solution;
+}
+
+/**
+ * @brief The solveAllTargets method will compute the optimal solution of every target of the board in a single search.
+ * @details The robots start every round from the same cells, so the answers of all the rounds played on this board are known up front. They are used by solveRound until the board or the placement of the robots changes.
+ * 
+ */
+void Game::solveAllTargets(){
+    int cells[ROBOT_COUNT];
+    for(int i = 0; i < ROBOT_COUNT; i++){
+        cells[i] = this->board->cellOf(i);
+    }
+    Solver solver(this->board);
+    this->targetSolutions = solver.solveAll(this->robots);
+    this->targetSolutionsRevision = this->board->getRevision();
+    this->targetSolutionsStart = Solver::packState(cells);
+    for(int i = 0; i < this->targetSolutions.size(); i++){
+        Tile* tile = this->board->getTarget(i);
+        string target = colorToString(tile->getTargetColor()) + " " + string(1, tile->getTargetSymbol()) + " at (" + to_string(this->board->getCell(tile) % X_SIZE) + ", " + to_string(this->board->getCell(tile) / X_SIZE) + ")";
+        if(this->targetSolutions[i].solved){
+            log(LogLevel::INFO, "Target " + target + ": " + to_string(this->targetSolutions[i].moves.size()) + " moves");
+        }else{
+            log(LogLevel::INFO, "Target " + target + ": no solution");
+        }
+    }
+}
+
+/**
+ * @brief The editWalls method lets the players add or remove walls on the board.
+ * @details The robots are put back on their starting cells, then each command toggles one wall. Only the stops around the edited wall are recomputed, so the board is redrawn right away. Solving the round again can take as long as a round, so it is only done when asked for.
+ * 
+ */
+void Game::editWalls(){
+    const string sides = "NESW";
+    string input;
+    int x;
+    int y;
+    char side;
+    this->resetRobotsPosition();
+    while(true){
+        log(LogLevel::INFO, "Editor: enter x y side (N, E, S or W) to toggle a wall, s = solve the current round, e = exit");
+        cin >> input;
+        if(input == "e"){
+            log(LogLevel::INFO, "Exiting editor");
+            return;
+        }
+        if(input == "s"){
+            if(this->objectiveTile == nullptr){
+                log(LogLevel::INFO, "There is no round to solve yet");
+                continue;
+            }
+            Solution s = this->getSolution();
+            if(s.solved){
+                log(LogLevel::INFO, "The optimal solution is now " + to_string(s.moves.size()) + " moves");
+            }else{
+                log(LogLevel::INFO, "The round can no longer be solved");
+            }
+            continue;
+        }
+        istringstream field(input);
+        if(!(field >> x) || !field.eof() || !(cin >> y >> side) || sides.find(toupper(side)) == string::npos){
+            cin.clear();
+            cin.ignore(numeric_limits<streamsize>::max(), '\n');
+            log(LogLevel::INFO, "Unknown input");
+            continue;
+        }
+        if(this->board->toggleWall(x, y, sides.find(toupper(side)))){
+            this->board->drawBoard(this->objectiveTile);
+        }
+    }
 }
\ No newline at end of file
@@ -12,12 +12,30 @@
 #ifndef GAME_H
 #define GAME_H
 
+#include "anytime.h"
 #include "board.h"
+#include "cache.h"
+#include "evaluator.h"
+#include "ida.h"
 #include "player.h"
+#include "quadrants.h"
 #include "robot.h"
+#include "solver.h"
+#include <atomic>
 #include <chrono>
+#include <future>
 #include <thread>
 
+/**
+ * The number of deflectors added to the board by the diagonal variant.
+ */
+const int DEFLECTOR_COUNT = 8;
+
+/**
+ * The number of seconds the players have to beat the first bid of a round, also the time the solver gets to answer.
+ */
+const int ROUND_SECONDS = 60;
+
 /**
  * @brief The Game class represents the game
  * @details In each round, one of the players flips over an objective tile. The goal is to move the robot with the color matching the tile to the objective square with the same symbol as the tile. If the multicolored tile is drawn, the objective is to move any robot to the multicolored square on the grid.
@@ -31,17 +49,32 @@ class Game{
         Tile *objectiveTile;
         int timer;
         int movecountgoal;
-        Robot *robots[4];
+        Robot *robots[ROBOT_COUNT];
         vector<Player*> players;
         Player *currentPlayer;
         bool timerRunning;
         chrono::time_point<chrono::high_resolution_clock> startTime;
         chrono::time_point<chrono::high_resolution_clock> endTime;
         int timerDuration;
-
+        Solution solution;
+        unsigned long solutionRevision;
+        vector<Solution> targetSolutions;
+        unsigned long targetSolutionsRevision;
+        State targetSolutionsStart;
+        future<Solution> pendingSolution;
+        // The searches that solved the round in the background, handed to the evaluator
+        shared_ptr<const BidirectionalSolver> roundSearch;
+        unsigned long pendingRevision;
+        uint64_t pendingKey;
+        SolutionCache cache;
+        // The fewest moves the round is proven to need, INT_MAX if it cannot be solved
+        atomic<int> solutionLowerBound;
+        unique_ptr<Evaluator> evaluator;
+        // Declared last so that the solving thread is stopped before the members it writes are destroyed
+        jthread roundSolver;
 
     public:
-        Game(Board* b, vector<Player*> p, Robot* r[4]);
+        Game(Board* b, vector<Player*> p, Robot* r[ROBOT_COUNT]);
         Board* getBoard();
         void placeRobots();
         Robot* getRobot(int n);
@@ -49,6 +82,8 @@ class Game{
         void drawObjectiveTile();
         void setBoard(Board* b);
         void initGame();
+        void newBoard();
+        void newClassicBoard(int layout);
         void startTimer(int seconds);
         void stopTimer();
         int getTimer();
@@ -56,13 +91,23 @@ class Game{
         Tile* getObjectiveTile();
         void selectPlayer();
         void setMoveCount();
-        void moveRobot();
+        bool moveRobot();
         void updateScore();
         void newRound();
         void getInputs();
         void play();
         void resetRobotsPosition();
         bool isRoundSolved(Tile* objectiveTile);
+        void stopSolving();
+        void startSolving();
+        void finishSolving();
+        bool checkBid();
+        void startEvaluator();
+        void evaluateMove();
+        void solveRound();
+        Solution getSolution();
+        void solveAllTargets();
+        void editWalls();
 };
 
 #endif // GAME_H
\ No newline at end of file
@@ -0,0 +1,339 @@
+/**
+ * @file ida.cpp
+ * @author Bastien
+ * @brief Class for the iterative deepening solver (Implementation File)
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+#include "ida.h"
+#include "log.h"
+#include <climits>
+
+/**
+ * The value returned by search when a solution was found.
+ */
+const int FOUND = -1;
+
+/**
+ * The value returned by search when the stop token was triggered or the deadline passed.
+ */
+const int CANCELLED = -2;
+
+/**
+ * @brief Construct a new IdaSolver:: IdaSolver object
+ *
+ * @param b The board to solve, its current snapshot is used
+ */
+IdaSolver::IdaSolver(Board* b) : IdaSolver(b->getSnapshot()){
+}
+
+/**
+ * @brief Construct a new IdaSolver:: IdaSolver object
+ *
+ * @param b The snapshot of the board to solve
+ */
+IdaSolver::IdaSolver(shared_ptr<const BoardSnapshot> b){
+    this->board = b;
+    this->patterns = make_shared<PatternStore>(b);
+    this->patternGain = 0;
+    this->table.assign(IDA_TABLE_SIZE, {0, 0, 0});
+    this->iteration = 0;
+    this->nodes = 0;
+    this->maxDepth = IDA_MAX_DEPTH;
+    this->lowerBound = 0;
+    this->cancelled = false;
+    this->deadline = chrono::steady_clock::time_point::max();
+    for(int i = 0; i < ROBOT_COUNT; i++){
+        this->eligible[i] = false;
+    }
+}
+
+/**
+ * @brief The setMaxDepth function sets the deepest search tried before giving up
+ * @details It can be lowered from the progress callback, when a solution of that many moves is already known.
+ *
+ * @param depth At most IDA_MAX_DEPTH
+ */
+void IdaSolver::setMaxDepth(int depth){
+    this->maxDepth = min(depth, IDA_MAX_DEPTH);
+}
+
+/**
+ * @brief The setPatterns function sets where the pattern databases used to raise the lower bound come from
+ * @details By default the solver has its own store, saving in PATTERN_DIRECTORY. Solvers of the same snapshot can share one, so each database is only loaded or built once.
+ *
+ * @param patterns The store of the same snapshot as the solver, or nullptr to use the distance maps only
+ */
+void IdaSolver::setPatterns(shared_ptr<PatternStore> patterns){
+    if(patterns && patterns->getBoard() != this->board){
+        log(LogLevel::WARNING, "The pattern databases are not for this board, they will not be used");
+        patterns = nullptr;
+    }
+    this->patterns = patterns;
+}
+
+/**
+ * @brief The setStop function sets when the search has to give up
+ *
+ * @param token The search stops when a stop is requested on it
+ * @param deadline The search stops when this time is reached
+ */
+void IdaSolver::setStop(stop_token token, chrono::steady_clock::time_point deadline){
+    this->stopToken = token;
+    this->deadline = deadline;
+}
+
+/**
+ * @brief The setProgress function sets the function called after each iteration without a solution
+ *
+ * @param progress Called with the new lower bound, from the thread running the search
+ */
+void IdaSolver::setProgress(function<void(int)> progress){
+    this->progress = progress;
+}
+
+/**
+ * @brief The getLowerBound function returns the number of moves the last search proved the round needs at least
+ *
+ * @return The bound, or INT_MAX if the target cannot be reached
+ */
+int IdaSolver::getLowerBound() const{
+    return this->lowerBound;
+}
+
+/**
+ * @brief The isCancelled function checks if the last search gave up because of the stop token or the deadline
+ *
+ * @return true
+ * @return false
+ */
+bool IdaSolver::isCancelled() const{
+    return this->cancelled;
+}
+
+/**
+ * @brief The shouldStop function checks the stop token and the deadline
+ *
+ * @return true
+ * @return false
+ */
+bool IdaSolver::shouldStop() const{
+    return this->stopToken.stop_requested() || chrono::steady_clock::now() >= this->deadline;
+}
+
+/**
+ * @brief The solve function solves the current round
+ * @details Same goal as Solver::solve: the robot matching the color of the objective tile has to reach it, or any robot if the objective tile is multicolored.
+ *
+ * @param robots The robots of the game
+ * @param objectiveTile The objective tile
+ * @return Solution
+ */
+Solution IdaSolver::solve(Robot* robots[ROBOT_COUNT], Tile* objectiveTile){
+    int cells[ROBOT_COUNT];
+    int targetRobot = -1;
+    for(int i = 0; i < ROBOT_COUNT; i++){
+        cells[i] = robots[i]->getCell();
+        if(robots[i]->getColor() == objectiveTile->getTargetColor()){
+            targetRobot = i;
+        }
+    }
+    int targetCell = robots[0]->getBoard()->getCell(objectiveTile);
+    return this->solve(Solver::packState(cells), targetCell, targetRobot);
+}
+
+/**
+ * @brief The solve function runs an iterative deepening A* search from a start state
+ * @details The distance maps of the targets are read from the snapshot, any other cell gets its map computed here. The pattern databases of the target cell are taken from the store, which reads them from disk or builds them the first time.
+ *
+ * @param start The start state
+ * @param targetCell The cell to reach
+ * @param targetRobot The robot that has to reach the cell, or -1 if any robot can reach it
+ * @return Solution
+ */
+Solution IdaSolver::solve(State start, int targetCell, int targetRobot){
+    Solution solution;
+    solution.solved = false;
+    solution.nodes = 0;
+
+    int target = this->board->findTarget(targetCell);
+    for(int i = 0; i < ROBOT_COUNT; i++){
+        this->eligible[i] = targetRobot == -1 || targetRobot == i;
+        if(!this->eligible[i]){
+            continue;
+        }
+        if(target == -1){
+            this->board->computeDistances(targetCell, i, this->distances[i]);
+            continue;
+        }
+        this->distances[i].resize(CELL_COUNT);
+        for(int cell = 0; cell < CELL_COUNT; cell++){
+            this->distances[i][cell] = this->board->getDistance(target, i, cell);
+        }
+    }
+
+    // The pattern databases of the target are loaded or built here, the first time the store is asked for them
+    this->databases.clear();
+    this->patternGain = 0;
+    for(int i = 0; i < ROBOT_COUNT; i++){
+        for(int helper = 0; helper < ROBOT_COUNT; helper++){
+            this->helpers[i][helper] = nullptr;
+            if(!this->patterns || !this->eligible[i] || helper == i){
+                continue;
+            }
+            this->databases.push_back(this->patterns->get(targetCell, i, helper));
+            this->helpers[i][helper] = this->databases.back().get();
+            for(int cell = 0; cell < CELL_COUNT; cell++){
+                int distance = this->distances[i][cell];
+                for(int helperCell = 0; helperCell < CELL_COUNT && distance != UNREACHABLE; helperCell++){
+                    int bound = this->helpers[i][helper]->get(cell, helperCell);
+                    if(helperCell == cell || bound <= distance){
+                        continue;
+                    }
+                    this->patternGain = max(this->patternGain, bound == PATTERN_UNREACHABLE ? IDA_MAX_DEPTH : bound - distance);
+                }
+            }
+        }
+    }
+
+    this->symmetry = Symmetry(*this->board, targetRobot);
+    this->nodes = 0;
+    this->moves.clear();
+    this->cancelled = false;
+    int bound = this->estimate(start, true);
+    this->lowerBound = bound;
+    while(bound <= this->maxDepth){
+        if(this->iteration == USHRT_MAX){
+            this->table.assign(IDA_TABLE_SIZE, {0, 0, 0});
+            this->iteration = 0;
+        }
+        this->iteration++;
+        log(LogLevel::DEBUG, "Iterative deepening solver searching " + to_string(bound) + " moves");
+        int next = this->search(start, 0, bound);
+        if(next == FOUND){
+            solution.solved = true;
+            solution.moves = this->moves;
+            break;
+        }
+        if(next == CANCELLED){
+            this->cancelled = true;
+            log(LogLevel::DEBUG, "Iterative deepening solver stopped while searching " + to_string(bound) + " moves");
+            break;
+        }
+        // No solution has fewer moves than the smallest bound cut in this iteration
+        bound = next;
+        this->lowerBound = bound;
+        if(this->progress){
+            this->progress(bound);
+        }
+    }
+
+    solution.nodes = this->nodes;
+    if(solution.solved){
+        log(LogLevel::DEBUG, "Iterative deepening solver found a solution in " + to_string(solution.moves.size()) + " moves after " + to_string(solution.nodes) + " nodes");
+    }else{
+        log(LogLevel::DEBUG, "Iterative deepening solver found no solution after " + to_string(solution.nodes) + " nodes");
+    }
+    return solution;
+}
+
+/**
+ * @brief The estimate function returns a lower bound of the number of moves left to solve the round from a state
+ *
+ * @param state
+ * @param patterns Whether the pattern databases raise the distance maps
+ * @return The smallest bound of an eligible robot, or INT_MAX if none of them can reach the target
+ */
+int IdaSolver::estimate(State state, bool patterns) const{
+    int best = INT_MAX;
+    for(int i = 0; i < ROBOT_COUNT; i++){
+        if(!this->eligible[i]){
+            continue;
+        }
+        int cell = Solver::getRobotCell(state, i);
+        int distance = this->distances[i][cell];
+        // Each pattern database is a lower bound on its own, so the largest one is too
+        for(int helper = 0; helper < ROBOT_COUNT && patterns && distance != UNREACHABLE; helper++){
+            if(this->helpers[i][helper] == nullptr){
+                continue;
+            }
+            int bound = this->helpers[i][helper]->get(cell, Solver::getRobotCell(state, helper));
+            if(bound == PATTERN_UNREACHABLE){
+                distance = UNREACHABLE;
+            }else if(bound > distance){
+                distance = bound;
+            }
+        }
+        if(distance != UNREACHABLE && distance < best){
+            best = distance;
+        }
+    }
+    return best;
+}
+
+/**
+ * @brief The search function runs a depth-first search from a state, cut when the moves made plus the lower bound of the moves left go over the bound
+ * @details The moves of the current path are kept in moves, so they hold the solution when one is found.
+ *
+ * @param state The current state
+ * @param depth The number of moves made to reach the state
+ * @param bound The largest number of moves allowed in this iteration
+ * @return FOUND, CANCELLED, or the smallest bound over this one that would let the search go further (INT_MAX if none)
+ */
+int IdaSolver::search(State state, int depth, int bound){
+    int estimate = this->estimate(state, false);
+    if(estimate == INT_MAX){
+        return INT_MAX;
+    }
+    if(estimate == 0){
+        return FOUND;
+    }
+    // The pattern databases are only looked up when they can raise the bound enough to cut the state
+    if(depth + estimate <= bound && depth + estimate + this->patternGain > bound){
+        estimate = this->estimate(state, true);
+        if(estimate == INT_MAX){
+            return INT_MAX;
+        }
+    }
+    if(depth + estimate > bound){
+        return depth + estimate;
+    }
+
+    // A state already searched with fewer moves in this iteration cannot lead to a solution now
+    State key = this->symmetry.canonical(state);
+    Entry& entry = this->table[((uint64_t)key * 0x9E3779B97F4A7C15ull) >> 44 & (IDA_TABLE_SIZE - 1)];
+    if(entry.iteration == this->iteration && entry.state == key && entry.depth <= depth){
+        return INT_MAX;
+    }
+    entry = {key, (unsigned char)depth, this->iteration};
+    this->nodes++;
+    if((this->nodes & (IDA_CHECK_INTERVAL - 1)) == 0 && this->shouldStop()){
+        return CANCELLED;
+    }
+
+    int best = INT_MAX;
+    for(int robot = 0; robot < ROBOT_COUNT; robot++){
+        int from = Solver::getRobotCell(state, robot);
+        for(int direction = 0; direction < 4; direction++){
+            int to = this->board->slide(RobotState(state), robot, direction);
+            if(to == from) continue;
+            this->moves.push_back({robot, Solver::directionToChar(direction)});
+            int next = this->search(Solver::setRobotCell(state, robot, to), depth + 1, bound);
+            if(next == FOUND){
+                return FOUND;
+            }
+            this->moves.pop_back();
+            if(next == CANCELLED){
+                return CANCELLED;
+            }
+            if(next < best){
+                best = next;
+            }
+        }
+    }
+    return best;
+}
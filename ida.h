@@ -0,0 +1,87 @@
+/**
+ * @file ida.h
+ * @author Bastien
+ * @brief Class for the iterative deepening solver
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+#ifndef IDA_H
+#define IDA_H
+
+#include "pattern.h"
+#include "solver.h"
+#include <chrono>
+#include <functional>
+#include <stop_token>
+
+/**
+ * The deepest search the iterative deepening solver tries before giving up on a round.
+ */
+const int IDA_MAX_DEPTH = 40;
+
+/**
+ * The number of entries of the transposition table of the iterative deepening solver, a power of 2.
+ */
+const int IDA_TABLE_SIZE = 1 << 20;
+
+/**
+ * The number of nodes between two checks of the stop token and of the deadline, a power of 2.
+ */
+const int IDA_CHECK_INTERVAL = 1 << 7;
+
+/**
+ * @brief The IdaSolver class computes the optimal solution of a round with an iterative deepening A* search.
+ * @details The search is a depth-first search bounded by the number of moves made plus a lower bound of the moves left (the largest of the distance map of a robot and of its pattern databases with each other robot, see PatternDatabase), the bound growing until a solution is found.
+ * Only the current path and a fixed size transposition table are kept, so memory does not grow with the number of positions as in the breadth-first Solver, at the cost of searching the first moves again at each iteration. getLowerBound returns the best bound proven so far, the search giving up on its stop token or deadline.
+ */
+class IdaSolver{
+    private:
+        struct Entry{
+            State state;
+            unsigned char depth;
+            unsigned short iteration;
+        };
+
+        shared_ptr<const BoardSnapshot> board;
+        vector<unsigned char> distances[ROBOT_COUNT];
+        bool eligible[ROBOT_COUNT];
+        Symmetry symmetry;
+        shared_ptr<PatternStore> patterns;
+        // For each eligible robot, the pattern databases with each other robot, kept alive by databases
+        const PatternDatabase* helpers[ROBOT_COUNT][ROBOT_COUNT];
+        vector<shared_ptr<const PatternDatabase>> databases;
+        // The most the pattern databases add to the distance maps, anywhere
+        int patternGain;
+        vector<Entry> table;
+        unsigned short iteration;
+        long long nodes;
+        vector<Move> moves;
+        int maxDepth;
+        int lowerBound;
+        bool cancelled;
+        stop_token stopToken;
+        chrono::steady_clock::time_point deadline;
+        function<void(int)> progress;
+
+        int estimate(State state, bool patterns) const;
+        int search(State state, int depth, int bound);
+        bool shouldStop() const;
+
+    public:
+        IdaSolver(Board* b);
+        IdaSolver(shared_ptr<const BoardSnapshot> b);
+        void setMaxDepth(int depth);
+        void setPatterns(shared_ptr<PatternStore> patterns);
+        void setStop(stop_token token, chrono::steady_clock::time_point deadline);
+        void setProgress(function<void(int)> progress);
+        int getLowerBound() const;
+        bool isCancelled() const;
+        Solution solve(Robot* robots[ROBOT_COUNT], Tile* objectiveTile);
+        Solution solve(State start, int targetCell, int targetRobot);
+};
+
+#endif // IDA_H
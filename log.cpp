@@ -2,10 +2,11 @@
 using namespace std;
 
 LogLevel minLogLevel = LogLevel::INFO; 
+thread_local LogLevel threadLogLevel = LogLevel::DEBUG;
 
 void log(LogLevel level, const string& message) {
 
-    if (level < minLogLevel) {
+    if (level < minLogLevel || level < threadLogLevel) {
         return; // If the log level is lower than the minimum, don't log the message
     }
 
@@ -29,7 +30,8 @@ void log(LogLevel level, const string& message) {
             colorCode = "\033[36m"; // Cyan
             levelString = "DEBUG";
             break;
-
+        case LogLevel::NONE:
+            return; // Only a minimum level, not the level of a message
     }
 
     cout << colorCode << "[" << levelString << "] " << message << "\033[0m" << endl;
@@ -37,4 +39,9 @@ void log(LogLevel level, const string& message) {
 
 void setLogLevel(LogLevel level) {
     minLogLevel = level;
-}
\ No newline at end of file
+}
+
+// A thread working in the background of the game raises it, so that its progress does not land between the prompts of the game
+void setThreadLogLevel(LogLevel level) {
+    threadLogLevel = level;
+}
@@ -2,15 +2,18 @@
 
 using namespace std;
 
+// From the least to the most severe, so that a minimum level keeps everything more severe than itself
 enum class LogLevel {
     DEBUG,
-    ERROR,
-    WARNING,
     INFO,
+    WARNING,
+    ERROR,
     NONE
 };
 
 extern LogLevel minLogLevel; // The minimum log level to log
+extern thread_local LogLevel threadLogLevel; // The minimum log level to log from the calling thread, on top of minLogLevel
 
 void log(LogLevel level, const string& message);
-void setLogLevel(LogLevel level);
\ No newline at end of file
+void setLogLevel(LogLevel level);
+void setThreadLogLevel(LogLevel level);
\ No newline at end of file
@@ -18,17 +18,15 @@ int main()
 {
   setLogLevel(loggingLevel);
 
-  vector<Player*> players;
-  Board* board = new Board();
-  Robot* robots[4];
-  for(int i = 0; i < 4; i++){
-    robots[i] = new Robot();
-  }
-  char colors[4] = {'R', 'B', 'G', 'Y'};
-  for(int i = 0; i < 4; i++){
-    robots[i]->setColor(colors[i]);
+  // The board, the robots and the players live for the whole game in this scope, the game only points to them
+  unique_ptr<Board> board = make_unique<Board>();
+  Robot robotStorage[ROBOT_COUNT];
+  Robot* robots[ROBOT_COUNT];
+  for(int i = 0; i < ROBOT_COUNT; i++){
+    robots[i] = &robotStorage[i];
+    robots[i]->setColor(ROBOT_COLORS[i]);
     robots[i]->setNumber(i);
-    robots[i]->setBoard(board);
+    robots[i]->setBoard(board.get());
   }
   int input;
   log(LogLevel::INFO, "Enter the number of players: ");
@@ -41,12 +39,13 @@ int main()
           log(LogLevel::ERROR, "Invalid number of players, please enter a number");
       }
   }
+  vector<Player> playerStorage(input);
+  vector<Player*> players;
   for(int i = 0; i < input; i++){
-    Player* p = new Player();
-    p->setNumber(i);
-    players.push_back(p);
+    playerStorage[i].setNumber(i);
+    players.push_back(&playerStorage[i]);
   }
-  Game game = Game(board, players, robots);
+  Game game = Game(board.get(), players, robots);
   game.initGame();
 
   return 0;
@@ -0,0 +1,507 @@
+/**
+ * @file parallel.cpp
+ * @author Bastien
+ * @brief Class for the multi-threaded solver (Implementation File)
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+#include "parallel.h"
+#include "log.h"
+#include <algorithm>
+
+/**
+ * @brief Construct a new VisitedSet:: VisitedSet object
+ *
+ * @param capacity The number of slots, a power of 2
+ */
+VisitedSet::VisitedSet(size_t capacity) : count(0){
+    this->capacity = capacity;
+    this->slots.reset(new atomic<State>[capacity]);
+    this->depths.reset(new unsigned char[capacity]);
+    for(size_t i = 0; i < capacity; i++){
+        this->slots[i].store(0, memory_order_relaxed);
+    }
+}
+
+/**
+ * @brief The insert function adds a state to the set
+ * @details Safe to call from any number of threads at once. The count of states is not updated here, so that the threads do not all write to the same counter: each of them adds its own count with addCount.
+ *
+ * @param state A valid state (not 0)
+ * @param depth The level the state was found at
+ * @return true if the state was not in the set yet
+ * @return false
+ */
+bool VisitedSet::insert(State state, unsigned char depth){
+    size_t mask = this->capacity - 1;
+    for(size_t i = ((uint64_t)state * 0x9E3779B97F4A7C15ull >> 17) & mask;; i = (i + 1) & mask){
+        State current = this->slots[i].load(memory_order_relaxed);
+        if(current == 0){
+            if(this->slots[i].compare_exchange_strong(current, state, memory_order_relaxed)){
+                this->depths[i] = depth;
+                return true;
+            }
+            // Another thread took the slot first, current now holds its state
+        }
+        if(current == state){
+            return false;
+        }
+    }
+}
+
+/**
+ * @brief The addCount function adds to the number of states in the set
+ *
+ * @param added The number of states a thread inserted
+ */
+void VisitedSet::addCount(size_t added){
+    this->count.fetch_add(added, memory_order_relaxed);
+}
+
+/**
+ * @brief The size function returns the number of states in the set, as counted with addCount
+ *
+ * @return size_t
+ */
+size_t VisitedSet::size() const{
+    return this->count.load(memory_order_relaxed);
+}
+
+/**
+ * @brief The getCapacity function returns the number of slots of the set
+ *
+ * @return size_t
+ */
+size_t VisitedSet::getCapacity() const{
+    return this->capacity;
+}
+
+/**
+ * @brief The getState function returns the state of a slot
+ * @details No other thread may add to the set meanwhile.
+ *
+ * @param slot From 0 to getCapacity() - 1
+ * @return State The state, or 0 if the slot is empty
+ */
+State VisitedSet::getState(size_t slot) const{
+    return this->slots[slot].load(memory_order_relaxed);
+}
+
+/**
+ * @brief The findDepth function returns the level a state was found at
+ * @details No other thread may add to the set meanwhile.
+ *
+ * @param state A valid state (not 0)
+ * @return int The level, or -1 if the state is not in the set
+ */
+int VisitedSet::findDepth(State state) const{
+    size_t mask = this->capacity - 1;
+    for(size_t i = ((uint64_t)state * 0x9E3779B97F4A7C15ull >> 17) & mask;; i = (i + 1) & mask){
+        State current = this->slots[i].load(memory_order_relaxed);
+        if(current == 0){
+            return -1;
+        }
+        if(current == state){
+            return this->depths[i];
+        }
+    }
+}
+
+/**
+ * @brief The getDepth function returns the level the state of a slot was found at
+ * @details No other thread may add to the set meanwhile.
+ *
+ * @param slot A slot that is not empty
+ * @return unsigned char
+ */
+unsigned char VisitedSet::getDepth(size_t slot) const{
+    return this->depths[slot];
+}
+
+/**
+ * @brief The grow function doubles the number of slots and adds the states again
+ * @details No other thread may use the set meanwhile.
+ *
+ */
+void VisitedSet::grow(){
+    unique_ptr<atomic<State>[]> old = move(this->slots);
+    unique_ptr<unsigned char[]> oldDepths = move(this->depths);
+    size_t oldCapacity = this->capacity;
+    this->capacity *= 2;
+    this->slots.reset(new atomic<State>[this->capacity]);
+    this->depths.reset(new unsigned char[this->capacity]);
+    for(size_t i = 0; i < this->capacity; i++){
+        this->slots[i].store(0, memory_order_relaxed);
+    }
+    for(size_t i = 0; i < oldCapacity; i++){
+        State state = old[i].load(memory_order_relaxed);
+        if(state != 0){
+            this->insert(state, oldDepths[i]);
+        }
+    }
+}
+
+/**
+ * @brief Construct a new ParallelSolver:: ParallelSolver object
+ *
+ * @param b The board to solve, its current snapshot is used
+ * @param threads The number of threads, or 0 for one per core
+ */
+ParallelSolver::ParallelSolver(Board* b, int threads) : ParallelSolver(b->getSnapshot(), threads){
+}
+
+/**
+ * @brief Construct a new ParallelSolver:: ParallelSolver object
+ * @details The threads are started here and kept until the solver is destroyed.
+ *
+ * @param b The snapshot of the board to solve
+ * @param threads The number of threads, or 0 for one per core
+ */
+ParallelSolver::ParallelSolver(shared_ptr<const BoardSnapshot> b, int threads){
+    this->board = b;
+    this->threadCount = threads > 0 ? threads : max(1, (int)thread::hardware_concurrency());
+    this->work = nullptr;
+    this->generation = 0;
+    this->running = 0;
+    this->stopping = false;
+    for(int i = 1; i < this->threadCount; i++){
+        this->workers.emplace_back(&ParallelSolver::serve, this, i);
+    }
+}
+
+/**
+ * @brief Destroy the ParallelSolver:: ParallelSolver object
+ * @details The threads are stopped and joined.
+ *
+ */
+ParallelSolver::~ParallelSolver(){
+    {
+        lock_guard<mutex> guard(this->lock);
+        this->stopping = true;
+    }
+    this->changed.notify_all();
+    for(thread& worker : this->workers){
+        worker.join();
+    }
+}
+
+/**
+ * @brief The getThreadCount function returns the number of threads the solver uses
+ *
+ * @return int
+ */
+int ParallelSolver::getThreadCount() const{
+    return this->threadCount;
+}
+
+/**
+ * @brief The serve function is the loop of a thread of the solver: it waits for a piece of work, runs it, and waits again until the solver is destroyed
+ *
+ * @param index The index the work is called with, from 1 to threadCount - 1
+ */
+void ParallelSolver::serve(int index){
+    unsigned long done = 0;
+    while(true){
+        const function<void(int)>* current;
+        {
+            unique_lock<mutex> guard(this->lock);
+            this->changed.wait(guard, [&]{ return this->stopping || this->generation != done; });
+            if(this->stopping){
+                return;
+            }
+            done = this->generation;
+            current = this->work;
+        }
+        (*current)(index);
+        {
+            lock_guard<mutex> guard(this->lock);
+            this->running--;
+        }
+        this->changed.notify_all();
+    }
+}
+
+/**
+ * @brief The run function runs a piece of work on every thread and waits for all of them
+ * @details The calling thread takes the index 0, the threads of the solver the others.
+ *
+ * @param work A function called with the index of the thread, from 0 to threadCount - 1
+ */
+void ParallelSolver::run(const function<void(int)>& work){
+    {
+        lock_guard<mutex> guard(this->lock);
+        this->work = &work;
+        this->running = this->threadCount - 1;
+        this->generation++;
+    }
+    this->changed.notify_all();
+    work(0);
+    unique_lock<mutex> guard(this->lock);
+    this->changed.wait(guard, [&]{ return this->running == 0; });
+}
+
+/**
+ * @brief The solve function solves the current round
+ * @details Same goal as Solver::solve: the robot matching the color of the objective tile has to reach it, or any robot if the objective tile is multicolored.
+ *
+ * @param robots The robots of the game
+ * @param objectiveTile The objective tile
+ * @return Solution
+ */
+Solution ParallelSolver::solve(Robot* robots[ROBOT_COUNT], Tile* objectiveTile){
+    int cells[ROBOT_COUNT];
+    int targetRobot = -1;
+    for(int i = 0; i < ROBOT_COUNT; i++){
+        cells[i] = robots[i]->getCell();
+        if(robots[i]->getColor() == objectiveTile->getTargetColor()){
+            targetRobot = i;
+        }
+    }
+    int targetCell = robots[0]->getBoard()->getCell(objectiveTile);
+    return this->solve(Solver::packState(cells), targetCell, targetRobot);
+}
+
+/**
+ * @brief The solve function runs a level by level breadth-first search from a start state on all the threads
+ *
+ * @param start The start state
+ * @param targetCell The cell to reach
+ * @param targetRobot The robot that has to reach the cell, or -1 if any robot can reach it
+ * @return Solution
+ */
+Solution ParallelSolver::solve(State start, int targetCell, int targetRobot){
+    Solution solution;
+    solution.solved = false;
+    solution.nodes = 0;
+
+    auto isGoal = [&](State state){
+        for(int i = 0; i < ROBOT_COUNT; i++){
+            if((targetRobot == -1 || targetRobot == i) && Solver::getRobotCell(state, i) == targetCell){
+                return true;
+            }
+        }
+        return false;
+    };
+    if(isGoal(start)){
+        solution.solved = true;
+        return solution;
+    }
+    // The search runs on canonical states, the swappable robots being sorted
+    Symmetry symmetry(*this->board, targetRobot);
+    State real = start;
+    start = symmetry.canonical(start);
+
+    // The earlier levels are only kept in the visited set, with the level of each state
+    vector<State> frontier(1, start);
+    int depth = 0;
+    VisitedSet visited(PARALLEL_INITIAL_CAPACITY);
+    visited.insert(start, 0);
+    visited.addCount(1);
+    // The states a batch of chunks may add before the threads check the load again
+    size_t headroom = (size_t)this->threadCount * PARALLEL_CHUNK_SIZE * ROBOT_COUNT * 4;
+
+    State goal = 0;
+    while(goal == 0 && !frontier.empty()){
+        size_t chunkCount = (frontier.size() + PARALLEL_CHUNK_SIZE - 1) / PARALLEL_CHUNK_SIZE;
+        atomic<size_t> nextChunk(0);
+        vector<vector<State>> parts(this->threadCount);
+        vector<State> goals(this->threadCount, 0);
+        vector<long long> expanded(this->threadCount, 0);
+
+        while(nextChunk.load() < chunkCount){
+            // The set only grows between two batches, when no thread is using it
+            while(visited.size() + headroom > visited.getCapacity() / 4 * 3){
+                visited.grow();
+            }
+            atomic<bool> full(false);
+            this->run([&](int t){
+                while(!full.load(memory_order_relaxed)){
+                    if(visited.size() + headroom > visited.getCapacity() / 4 * 3){
+                        full.store(true, memory_order_relaxed);
+                        break;
+                    }
+                    size_t chunk = nextChunk.fetch_add(1);
+                    if(chunk >= chunkCount){
+                        break;
+                    }
+                    size_t added = 0;
+                    size_t end = min(frontier.size(), (chunk + 1) * PARALLEL_CHUNK_SIZE);
+                    State successors[EXPAND_BATCH_SIZE * MOVE_COUNT];
+                    for(size_t i = chunk * PARALLEL_CHUNK_SIZE; i < end; i += EXPAND_BATCH_SIZE){
+                        int count = min(end - i, (size_t)EXPAND_BATCH_SIZE);
+                        this->board->expand(&frontier[i], count, successors);
+                        expanded[t] += count;
+                        for(int j = 0; j < count * MOVE_COUNT; j++){
+                            if(successors[j] == frontier[i + j / MOVE_COUNT]) continue;
+                            State next = symmetry.canonical(successors[j]);
+                            if(!visited.insert(next, depth + 1)) continue;
+                            added++;
+                            parts[t].push_back(next);
+                            if(isGoal(next) && (goals[t] == 0 || next < goals[t])){
+                                goals[t] = next;
+                            }
+                        }
+                    }
+                    visited.addCount(added);
+                }
+            });
+        }
+
+        vector<State> level;
+        for(int t = 0; t < this->threadCount; t++){
+            solution.nodes += expanded[t];
+            level.insert(level.end(), parts[t].begin(), parts[t].end());
+            vector<State>().swap(parts[t]);
+            if(goals[t] != 0 && (goal == 0 || goals[t] < goal)){
+                goal = goals[t];
+            }
+        }
+        frontier = move(level);
+        depth++;
+    }
+
+    if(goal == 0){
+        log(LogLevel::DEBUG, "Parallel solver found no solution after " + to_string(solution.nodes) + " nodes");
+        return solution;
+    }
+
+    // Walk back one level at a time, the goal being in the last one
+    vector<State>().swap(frontier);
+    State child = goal;
+    for(int level = depth - 1; level >= 0; level--){
+        State parent;
+        unsigned char move;
+        if(!this->findParent(visited, level, symmetry, child, parent, move)){
+            log(LogLevel::ERROR, "Parallel solver lost the path of its solution");
+            return solution;
+        }
+        solution.moves.push_back({move / 4, Solver::directionToChar(move % 4)});
+        child = parent;
+    }
+    reverse(solution.moves.begin(), solution.moves.end());
+    solution.moves = symmetry.mapMoves(*this->board, real, solution.moves);
+    solution.solved = true;
+    log(LogLevel::DEBUG, "Parallel solver found a solution in " + to_string(solution.moves.size()) + " moves after " + to_string(solution.nodes) + " nodes on " + to_string(this->threadCount) + " threads");
+    return solution;
+}
+
+/**
+ * @brief The getMove function finds the smallest move leading from a state to another
+ * @details A move changes the cell of one robot only, so the robot that moved is the only one whose cell is not in the child. The states with more than one such robot are skipped without sliding anything.
+ *
+ * @param state
+ * @param child
+ * @param symmetry The symmetry the states of the search were put in canonical form with
+ * @return int The move (robot * 4 + direction), or -1 if no move leads to the child
+ */
+int ParallelSolver::getMove(State state, State child, const Symmetry& symmetry) const{
+    RobotState childRobots(child);
+    int robot = -1;
+    int moved = 0;
+    for(int r = 0; r < ROBOT_COUNT && moved < 2; r++){
+        if(childRobots.robotAt(Solver::getRobotCell(state, r)) == -1){
+            robot = r;
+            moved++;
+        }
+    }
+    if(moved != 1){
+        return -1;
+    }
+    for(int direction = 0; direction < 4; direction++){
+        int to = this->board->slide(RobotState(state), robot, direction);
+        if(symmetry.canonical(Solver::setRobotCell(state, robot, to)) == child){
+            return robot * 4 + direction;
+        }
+    }
+    return -1;
+}
+
+/**
+ * @brief The findParent function finds the smallest state of a level, and its smallest move, leading to a state
+ * @details Without deflectors, the parents are found with reverse moves (see BoardSnapshot::unslide): the child is the canonical form of the state reached, so every placement of the swappable robots on its cells is undone, one robot and one direction at a time, and the states found at the level are kept. With deflectors, the slots of the visited set are shared out between the threads and every state of the level is tried.
+ *
+ * @param visited The states of the search
+ * @param depth The level before the child
+ * @param symmetry The symmetry the states of the search were put in canonical form with
+ * @param child
+ * @param parent The parent found
+ * @param move The move found (robot * 4 + direction)
+ * @return true if a parent was found
+ * @return false
+ */
+bool ParallelSolver::findParent(const VisitedSet& visited, int depth, const Symmetry& symmetry, State child, State& parent, unsigned char& move){
+    vector<State> parents(this->threadCount, 0);
+    vector<int> moves(this->threadCount, -1);
+    if(!this->board->hasDeflectors()){
+        vector<State> placements(1, child);
+        for(const vector<int>& robots : symmetry.getClasses()){
+            vector<State> next;
+            for(State state : placements){
+                vector<int> cells;
+                for(int robot : robots){
+                    cells.push_back(Solver::getRobotCell(state, robot));
+                }
+                sort(cells.begin(), cells.end());
+                do{
+                    for(int k = 0; k < robots.size(); k++){
+                        state = Solver::setRobotCell(state, robots[k], cells[k]);
+                    }
+                    next.push_back(state);
+                }while(next_permutation(cells.begin(), cells.end()));
+            }
+            placements.swap(next);
+        }
+        vector<int> cells;
+        for(State placement : placements){
+            RobotState robots(placement);
+            for(int robot = 0; robot < ROBOT_COUNT; robot++){
+                for(int direction = 0; direction < 4; direction++){
+                    this->board->unslide(robots, robot, direction, cells);
+                    for(int from : cells){
+                        State state = symmetry.canonical(Solver::setRobotCell(placement, robot, from));
+                        if((moves[0] != -1 && state >= parents[0]) || visited.findDepth(state) != depth){
+                            continue;
+                        }
+                        int found = this->getMove(state, child, symmetry);
+                        if(found != -1){
+                            parents[0] = state;
+                            moves[0] = found;
+                        }
+                    }
+                }
+            }
+        }
+    }else{
+        this->run([&](int t){
+            size_t begin = visited.getCapacity() * t / this->threadCount;
+            size_t end = visited.getCapacity() * (t + 1) / this->threadCount;
+            for(size_t i = begin; i < end; i++){
+                State state = visited.getState(i);
+                if(state == 0 || visited.getDepth(i) != depth || (moves[t] != -1 && state > parents[t])){
+                    continue;
+                }
+                int found = this->getMove(state, child, symmetry);
+                if(found != -1){
+                    parents[t] = state;
+                    moves[t] = found;
+                }
+            }
+        });
+    }
+    int best = -1;
+    for(int t = 0; t < this->threadCount; t++){
+        if(moves[t] != -1 && (best == -1 || parents[t] < parents[best] || (parents[t] == parents[best] && moves[t] < moves[best]))){
+            best = t;
+        }
+    }
+    if(best == -1){
+        return false;
+    }
+    parent = parents[best];
+    move = moves[best];
+    return true;
+}
@@ -0,0 +1,91 @@
+/**
+ * @file parallel.h
+ * @author Bastien
+ * @brief Class for the multi-threaded solver
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+#include "solver.h"
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * The number of states a worker takes from the frontier at a time.
+ */
+const int PARALLEL_CHUNK_SIZE = 1024;
+
+/**
+ * The number of slots the visited set starts with, a power of 2.
+ */
+const size_t PARALLEL_INITIAL_CAPACITY = 1 << 22;
+
+/**
+ * @brief The VisitedSet class is a set of states that many threads can add to at the same time without locks, with the level each state was found at.
+ * @details It is an open addressing hash table with linear probing, each slot being claimed with a compare and swap. The empty slot is the state 0, which is never a valid state as it puts every robot on the same cell. The level of a slot is written by the thread that claimed it, and is only read once the threads are done with the level.
+ * The table cannot grow while threads add to it: the owner checks the load between two batches and calls grow when no other thread uses it.
+ */
+class VisitedSet{
+    private:
+        unique_ptr<atomic<State>[]> slots;
+        unique_ptr<unsigned char[]> depths;
+        size_t capacity;
+        atomic<size_t> count;
+
+    public:
+        VisitedSet(size_t capacity);
+        bool insert(State state, unsigned char depth);
+        void addCount(size_t added);
+        size_t size() const;
+        size_t getCapacity() const;
+        State getState(size_t slot) const;
+        unsigned char getDepth(size_t slot) const;
+        int findDepth(State state) const;
+        void grow();
+};
+
+/**
+ * @brief The ParallelSolver class computes the optimal solution of a round with a breadth-first search spread over several threads.
+ * @details The search goes one level (number of moves) at a time. The workers take chunks of the current frontier, slide every robot of every state and add the new states to a shared VisitedSet and to their own part of the next frontier. The threads meet at the end of each level. Only the frontier and the next level are kept as lists, the earlier levels being known from the level of each state in the VisitedSet.
+ * The threads are started with the solver and wait between two pieces of work (see run), so no thread is started per level or per batch.
+ * Like Solver, the search runs on canonical states (see Symmetry). The result does not depend on the threads: the states of a level are the same whatever the order they were found in, the goal is the smallest goal state of the first level holding one, and the path is rebuilt backwards by taking, at each level, the smallest state (then the smallest move) leading to the next state of the path.
+ */
+class ParallelSolver{
+    private:
+        shared_ptr<const BoardSnapshot> board;
+        int threadCount;
+        // The threads other than the calling one, waiting for the work given to run
+        vector<thread> workers;
+        mutex lock;
+        condition_variable changed;
+        const function<void(int)>* work;
+        unsigned long generation;
+        int running;
+        bool stopping;
+
+        void serve(int index);
+        void run(const function<void(int)>& work);
+        int getMove(State state, State child, const Symmetry& symmetry) const;
+        bool findParent(const VisitedSet& visited, int depth, const Symmetry& symmetry, State child, State& parent, unsigned char& move);
+
+    public:
+        ParallelSolver(Board* b, int threads);
+        ParallelSolver(shared_ptr<const BoardSnapshot> b, int threads);
+        ~ParallelSolver();
+        int getThreadCount() const;
+        Solution solve(Robot* robots[ROBOT_COUNT], Tile* objectiveTile);
+        Solution solve(State start, int targetCell, int targetRobot);
+};
+
+#endif // PARALLEL_H
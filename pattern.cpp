@@ -0,0 +1,298 @@
+/**
+ * @file pattern.cpp
+ * @author Bastien
+ * @brief Classes for the pattern databases of the heuristic search (Implementation File)
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+#include "pattern.h"
+#include "log.h"
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+/**
+ * The first bytes of a pattern database file, followed by the version of the format.
+ */
+const char PATTERN_MAGIC[4] = {'R', 'R', 'P', 'D'};
+const uint32_t PATTERN_VERSION = 1;
+
+/**
+ * @brief The header of a pattern database file, followed by the packed distances.
+ */
+struct PatternHeader{
+    char magic[4];
+    uint32_t version;
+    uint32_t cells;
+    uint32_t targetCell;
+    uint64_t hash;
+};
+
+/**
+ * @brief The moves of a group of robots that may stop anywhere on their path, stored backwards for the search of the pattern databases.
+ * @details For each cell, the moves that can end on it: the starting cell, the direction and the place of the cell in the path, so that the cells crossed before it can be checked.
+ */
+struct RelaxedMoves{
+    struct Move{
+        Cell from;
+        unsigned char direction;
+        unsigned short index;
+    };
+    vector<uint32_t> pathStarts;
+    vector<Cell> paths;
+    vector<uint32_t> moveStarts;
+    vector<Move> moves;
+
+    RelaxedMoves(const BoardSnapshot& board, int robot){
+        vector<int> path;
+        this->pathStarts.assign(CELL_COUNT * 4 + 1, 0);
+        this->moveStarts.assign(CELL_COUNT + 1, 0);
+        for(int cell = 0; cell < CELL_COUNT; cell++){
+            for(int direction = 0; direction < 4; direction++){
+                board.getPath(robot, cell, direction, path);
+                for(int to : path){
+                    this->paths.push_back(to);
+                    this->moveStarts[to + 1]++;
+                }
+                this->pathStarts[cell * 4 + direction + 1] = this->paths.size();
+            }
+        }
+        for(int cell = 0; cell < CELL_COUNT; cell++){
+            this->moveStarts[cell + 1] += this->moveStarts[cell];
+        }
+        this->moves.resize(this->paths.size());
+        vector<uint32_t> next(this->moveStarts);
+        for(int cell = 0; cell < CELL_COUNT * 4; cell++){
+            for(uint32_t i = this->pathStarts[cell]; i < this->pathStarts[cell + 1]; i++){
+                this->moves[next[this->paths[i]]++] = {(Cell)(cell / 4), (unsigned char)(cell % 4), (unsigned short)(i - this->pathStarts[cell])};
+            }
+        }
+    }
+
+    // Whether a move goes through a cell before it ends
+    bool crosses(const Move& move, int cell) const{
+        const Cell* path = &this->paths[this->pathStarts[move.from * 4 + move.direction]];
+        for(int i = 0; i < move.index; i++){
+            if(path[i] == cell){
+                return true;
+            }
+        }
+        return false;
+    }
+};
+
+/**
+ * @brief Construct a new PatternDatabase:: PatternDatabase object, with every position unreachable
+ *
+ */
+PatternDatabase::PatternDatabase(){
+    this->distances.assign((CELL_COUNT * CELL_COUNT + 1) / 2, PATTERN_UNREACHABLE * 17);
+}
+
+/**
+ * @brief The set function stores the distance of a position
+ *
+ * @param index robotCell * CELL_COUNT + helperCell
+ * @param distance
+ */
+void PatternDatabase::set(int index, int distance){
+    int shift = (index & 1) * 4;
+    this->distances[index >> 1] = (this->distances[index >> 1] & ~(15 << shift)) | (distance << shift);
+}
+
+/**
+ * @brief The get function returns the lower bound of the number of moves left from a position
+ *
+ * @param robotCell The cell of the target robot
+ * @param helperCell The cell of the helper robot
+ * @return The number of moves (at most PATTERN_MAX_DISTANCE), or PATTERN_UNREACHABLE
+ */
+int PatternDatabase::get(int robotCell, int helperCell) const{
+    int index = robotCell * CELL_COUNT + helperCell;
+    return (this->distances[index >> 1] >> ((index & 1) * 4)) & 15;
+}
+
+/**
+ * @brief The build function computes the database by a breadth-first search backwards from the solved positions
+ *
+ * @param board
+ * @param targetCell The cell to reach
+ * @param robot A robot with the paths of the target robot
+ * @param helper A robot with the paths of the helper robot
+ */
+void PatternDatabase::build(const BoardSnapshot& board, int targetCell, int robot, int helper){
+    RelaxedMoves robotMoves(board, robot);
+    RelaxedMoves helperMoves(board, helper);
+
+    this->distances.assign((CELL_COUNT * CELL_COUNT + 1) / 2, PATTERN_UNREACHABLE * 17);
+    vector<unsigned char> depths(CELL_COUNT * CELL_COUNT, UNREACHABLE);
+    vector<uint32_t> queue;
+    for(int cell = 0; cell < CELL_COUNT; cell++){
+        if(cell != targetCell){
+            depths[targetCell * CELL_COUNT + cell] = 0;
+            queue.push_back(targetCell * CELL_COUNT + cell);
+        }
+    }
+    for(size_t head = 0; head < queue.size(); head++){
+        int robotCell = queue[head] / CELL_COUNT;
+        int helperCell = queue[head] % CELL_COUNT;
+        int depth = depths[queue[head]];
+        if(depth + 1 == UNREACHABLE){
+            continue;
+        }
+        auto visit = [&](int index){
+            if(depths[index] == UNREACHABLE){
+                depths[index] = depth + 1;
+                queue.push_back(index);
+            }
+        };
+        // The target robot came from a cell of the path that did not go through the helper
+        for(uint32_t i = robotMoves.moveStarts[robotCell]; i < robotMoves.moveStarts[robotCell + 1]; i++){
+            const RelaxedMoves::Move& move = robotMoves.moves[i];
+            if(move.from != helperCell && !robotMoves.crosses(move, helperCell)){
+                visit(move.from * CELL_COUNT + helperCell);
+            }
+        }
+        // Or the helper moved, without going through the target robot
+        for(uint32_t i = helperMoves.moveStarts[helperCell]; i < helperMoves.moveStarts[helperCell + 1]; i++){
+            const RelaxedMoves::Move& move = helperMoves.moves[i];
+            if(move.from != robotCell && !helperMoves.crosses(move, robotCell)){
+                visit(robotCell * CELL_COUNT + move.from);
+            }
+        }
+    }
+    for(int index = 0; index < CELL_COUNT * CELL_COUNT; index++){
+        if(depths[index] != UNREACHABLE){
+            this->set(index, min((int)depths[index], PATTERN_MAX_DISTANCE));
+        }
+    }
+}
+
+/**
+ * @brief The load function reads the database from a file
+ *
+ * @param path
+ * @param hash The hash of the board, the file is only used if it was saved for the same board
+ * @param targetCell The cell of the target, checked the same way
+ * @return true if the database was read
+ * @return false if the file is missing or does not match
+ */
+bool PatternDatabase::load(const string& path, uint64_t hash, int targetCell){
+    ifstream file(path, ios::binary);
+    if(!file){
+        return false;
+    }
+    PatternHeader header;
+    if(!file.read((char*)&header, sizeof(header)) || memcmp(header.magic, PATTERN_MAGIC, 4) != 0 || header.version != PATTERN_VERSION || header.cells != CELL_COUNT || header.targetCell != targetCell || header.hash != hash){
+        log(LogLevel::WARNING, "Pattern database " + path + " does not match the board");
+        return false;
+    }
+    vector<unsigned char> data(this->distances.size());
+    if(!file.read((char*)data.data(), data.size())){
+        log(LogLevel::WARNING, "Pattern database " + path + " is truncated");
+        return false;
+    }
+    this->distances.swap(data);
+    return true;
+}
+
+/**
+ * @brief The save function writes the database to a file
+ * @details The file is written next to its final name and renamed, so a run that stops midway never leaves a partial database behind.
+ *
+ * @param path
+ * @param hash The hash of the board
+ * @param targetCell The cell of the target
+ * @return true if the database was written
+ * @return false
+ */
+bool PatternDatabase::save(const string& path, uint64_t hash, int targetCell) const{
+    PatternHeader header;
+    memcpy(header.magic, PATTERN_MAGIC, 4);
+    header.version = PATTERN_VERSION;
+    header.cells = CELL_COUNT;
+    header.targetCell = targetCell;
+    header.hash = hash;
+    string temporary = path + ".tmp";
+    {
+        ofstream file(temporary, ios::binary | ios::trunc);
+        if(!file.write((const char*)&header, sizeof(header)) || !file.write((const char*)this->distances.data(), this->distances.size())){
+            log(LogLevel::WARNING, "Could not write pattern database " + path);
+            return false;
+        }
+    }
+    if(rename(temporary.c_str(), path.c_str()) != 0){
+        log(LogLevel::WARNING, "Could not write pattern database " + path);
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Construct a new PatternStore:: PatternStore object saving its databases in PATTERN_DIRECTORY
+ *
+ * @param b The snapshot of the board
+ */
+PatternStore::PatternStore(shared_ptr<const BoardSnapshot> b) : PatternStore(b, PATTERN_DIRECTORY){
+}
+
+/**
+ * @brief Construct a new PatternStore:: PatternStore object
+ *
+ * @param b The snapshot of the board
+ * @param directory The directory of the database files, or an empty string to keep them in memory only
+ */
+PatternStore::PatternStore(shared_ptr<const BoardSnapshot> b, const string& directory){
+    this->board = b;
+    this->directory = directory;
+}
+
+/**
+ * @brief The getBoard function returns the snapshot the databases are computed for
+ *
+ * @return shared_ptr<const BoardSnapshot>
+ */
+shared_ptr<const BoardSnapshot> PatternStore::getBoard() const{
+    return this->board;
+}
+
+/**
+ * @brief The get function returns the database of a target for a robot and a helper, loading or building it if needed
+ * @details Robots that follow the same paths share their databases.
+ *
+ * @param targetCell The cell to reach
+ * @param robot The target robot
+ * @param helper The helper robot
+ * @return shared_ptr<const PatternDatabase>
+ */
+shared_ptr<const PatternDatabase> PatternStore::get(int targetCell, int robot, int helper){
+    tuple<int, int, int> key(targetCell, this->board->getPathGroup(robot), this->board->getPathGroup(helper));
+    auto found = this->databases.find(key);
+    if(found != this->databases.end()){
+        return found->second;
+    }
+
+    shared_ptr<PatternDatabase> database = make_shared<PatternDatabase>();
+    string path;
+    if(!this->directory.empty()){
+        char name[64];
+        snprintf(name, sizeof(name), "%016llx-%d-%d-%d.pdb", (unsigned long long)this->board->getHash(), targetCell, std::get<1>(key), std::get<2>(key));
+        path = this->directory + "/" + name;
+    }
+    if(path.empty() || !database->load(path, this->board->getHash(), targetCell)){
+        log(LogLevel::DEBUG, "Building pattern database of cell " + to_string(targetCell) + " for robots " + to_string(robot) + " and " + to_string(helper));
+        database->build(*this->board, targetCell, robot, helper);
+        if(!path.empty()){
+            error_code error;
+            filesystem::create_directories(this->directory, error);
+            database->save(path, this->board->getHash(), targetCell);
+        }
+    }
+    this->databases[key] = database;
+    return database;
+}
@@ -0,0 +1,74 @@
+/**
+ * @file pattern.h
+ * @author Bastien
+ * @brief Classes for the pattern databases of the heuristic search
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+#ifndef PATTERN_H
+#define PATTERN_H
+
+#include "snapshot.h"
+#include <map>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <vector>
+
+/**
+ * The directory where the pattern databases are saved, relative to the working directory.
+ */
+const string PATTERN_DIRECTORY = "patterns";
+
+/**
+ * The largest distance a pattern database stores, larger distances are stored as this one (which keeps the bound admissible).
+ */
+const int PATTERN_MAX_DISTANCE = 14;
+
+/**
+ * The value a pattern database stores for the positions from which the target cannot be reached.
+ */
+const int PATTERN_UNREACHABLE = 15;
+
+/**
+ * @brief The PatternDatabase class holds a lower bound of the number of moves to reach a target cell for every pair of cells of the target robot and one helper robot.
+ * @details The other robots are left out, and to stay a lower bound whatever they do, the two robots may stop on any cell of their path, as if an untracked robot stood on the next one. The two robots still block each other. Moves of the untracked robots are free in this abstraction.
+ * A position is solved when the target robot stands on the target, so the distances are found by a breadth-first search backwards from these positions. They are packed 2 per byte, as they are small.
+ */
+class PatternDatabase{
+    private:
+        vector<unsigned char> distances;
+
+        void set(int index, int distance);
+
+    public:
+        PatternDatabase();
+        void build(const BoardSnapshot& board, int targetCell, int robot, int helper);
+        bool load(const string& path, uint64_t hash, int targetCell);
+        bool save(const string& path, uint64_t hash, int targetCell) const;
+        int get(int robotCell, int helperCell) const;
+};
+
+/**
+ * @brief The PatternStore class gives the pattern databases of a board, building them the first time they are needed.
+ * @details A database is looked for in memory, then on disk in a file named after the hash of the board (see BoardSnapshot::getHash), the target cell and the paths of the two robots. It is only built when neither has it, and then saved for the next run.
+ * The store is tied to one snapshot: when the board changes, a new store has to be made. It is not thread safe.
+ */
+class PatternStore{
+    private:
+        shared_ptr<const BoardSnapshot> board;
+        string directory;
+        map<tuple<int, int, int>, shared_ptr<const PatternDatabase>> databases;
+
+    public:
+        PatternStore(shared_ptr<const BoardSnapshot> b);
+        PatternStore(shared_ptr<const BoardSnapshot> b, const string& directory);
+        shared_ptr<const BoardSnapshot> getBoard() const;
+        shared_ptr<const PatternDatabase> get(int targetCell, int robot, int helper);
+};
+
+#endif // PATTERN_H
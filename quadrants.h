@@ -0,0 +1,207 @@
+/**
+ * @file quadrants.h
+ * @author Bastien
+ * @brief Compile-time table of the printed quarters of the original game
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+#ifndef QUADRANTS_H
+#define QUADRANTS_H
+
+const int QUADRANT_SIZE = 8;
+const int QUADRANT_CELLS = QUADRANT_SIZE * QUADRANT_SIZE;
+const int QUADRANT_PIECES = 4;
+const int QUADRANT_SIDES = 2;
+
+/**
+ * The number of different official boards: the first quarter stays in the top left corner (turning the whole board gives the same game), the 3 others can be put in any order and each of the 4 quarters can be flipped.
+ */
+const int CLASSIC_BOARD_COUNT = 6 * 16;
+
+/**
+ * @brief A cell of a printed quarter.
+ * @details The walls use the same bits as the tiles (1 = top, 2 = right, 4 = bottom, 8 = left). The color and the symbol are ' ' when the cell has no target.
+ */
+struct QuadrantCell{
+    unsigned char walls;
+    char color;
+    char symbol;
+    bool central;
+
+    constexpr QuadrantCell() : walls(0), color(' '), symbol(' '), central(false){}
+};
+
+/**
+ * @brief The cells of every side of every quarter, already turned for each place on the board.
+ * @details cells[piece][side][rotation] is the quarter turned rotation quarter turns clockwise, which is how it is laid at place rotation on the board (0 = top left, 1 = top right, 2 = bottom right, 3 = bottom left). Cells are numbered y * QUADRANT_SIZE + x.
+ */
+struct QuadrantTable{
+    QuadrantCell cells[QUADRANT_PIECES][QUADRANT_SIDES][4][QUADRANT_CELLS];
+};
+
+/**
+ * The printed quarters, as laid in the top left corner of the board (the central square is at the bottom right of the quarter).
+ * One cell per entry, row by row: N, E, S and W are the walls, R, G, B and Y the color of the target and C, T, Q and H its symbol (circle, triangle, square and hexagon). MV is the multicolored vortex. X is an empty cell.
+ * The last quarter has the vortex on both sides, so every official board has the 17 targets of the game: 4 of each color and the vortex.
+ */
+constexpr const char* QUADRANT_LAYOUTS[QUADRANT_PIECES][QUADRANT_SIDES] = {
+    {
+        "NW,N,N,N,NE,NW,N,N,"
+        "W,S,X,X,X,X,SEYH,W,"
+        "WE,NWGT,X,X,X,X,N,X,"
+        "W,X,X,X,X,X,X,X,"
+        "W,X,X,X,X,X,S,X,"
+        "SW,X,X,X,X,X,NEBQ,W,"
+        "NW,X,E,SWRC,X,X,X,S,"
+        "W,X,X,N,X,X,E,NW",
+
+        "NW,NE,NW,N,NS,N,N,N,"
+        "W,S,X,E,NWRC,X,X,X,"
+        "W,NEGT,W,X,X,X,X,X,"
+        "W,X,X,X,X,X,SEYH,W,"
+        "W,X,X,X,X,X,N,X,"
+        "SW,X,X,X,X,X,X,X,"
+        "NW,X,E,SWBQ,X,X,X,S,"
+        "W,X,X,N,X,X,E,NW"
+    },
+    {
+        "NW,N,N,NE,NW,N,N,N,"
+        "W,X,X,X,X,E,SWBC,X,"
+        "W,S,X,X,X,X,N,X,"
+        "W,NEYT,W,X,X,S,X,X,"
+        "W,X,X,X,E,NWGQ,X,X,"
+        "W,X,SERH,W,X,X,X,X,"
+        "SW,X,N,X,X,X,X,S,"
+        "NW,X,X,X,X,X,E,NW",
+
+        "NW,N,N,N,NE,NW,N,N,"
+        "W,X,SERH,W,X,X,X,X,"
+        "W,X,N,X,X,X,X,X,"
+        "WE,SWGQ,X,X,X,X,S,X,"
+        "SW,N,X,X,X,E,NWYT,X,"
+        "NW,X,X,X,X,S,X,X,"
+        "W,X,X,X,X,NEBC,W,S,"
+        "W,X,X,X,X,X,E,NW"
+    },
+    {
+        "NW,N,N,NE,NW,N,N,N,"
+        "W,X,X,X,X,SEGH,W,X,"
+        "WE,SWRQ,X,X,X,N,X,X,"
+        "SW,N,X,X,X,X,S,X,"
+        "NW,X,X,X,X,E,NWYC,X,"
+        "W,X,S,X,X,X,X,X,"
+        "W,X,NEBT,W,X,X,X,S,"
+        "W,X,X,X,X,X,E,NW",
+
+        "NW,N,NS,N,NE,NW,N,N,"
+        "W,E,NWYC,X,X,X,X,X,"
+        "W,X,X,X,X,X,X,X,"
+        "W,X,X,X,X,E,SWBT,X,"
+        "SW,X,X,X,S,X,N,X,"
+        "NW,X,X,X,NERQ,W,X,X,"
+        "W,SEGH,W,X,X,X,X,S,"
+        "W,N,X,X,X,X,E,NW"
+    },
+    {
+        "NW,N,N,NE,NW,N,N,N,"
+        "W,X,X,X,X,X,X,X,"
+        "W,X,X,SEMV,X,SEBH,W,X,"
+        "W,X,S,X,X,N,X,X,"
+        "SW,X,NEGC,W,X,X,X,X,"
+        "NW,S,X,X,X,X,E,SWRT,"
+        "WE,NWYQ,X,X,X,X,X,NS,"
+        "W,X,X,X,X,X,E,NW",
+
+        "NW,N,N,NE,NW,N,N,N,"
+        "WE,SWRT,X,X,X,X,S,X,"
+        "W,N,X,X,NWMV,X,NEGC,W,"
+        "W,X,X,X,X,X,X,X,"
+        "W,X,SEBH,W,X,X,X,S,"
+        "SW,X,N,X,X,X,E,NWYQ,"
+        "NW,X,X,X,X,X,X,S,"
+        "W,X,X,X,X,X,E,NW"
+    }
+};
+
+/**
+ * @brief The parseQuadrant function reads a printed quarter from its text layout.
+ * @details Each wall is also set on the cell on the other side of it, so that the tiles of the board agree on every wall.
+ *
+ * @param text The layout, see QUADRANT_LAYOUTS
+ * @param cells The cells of the quarter
+ */
+constexpr void parseQuadrant(const char* text, QuadrantCell* cells){
+    for(int i = 0; i < QUADRANT_CELLS; i++){
+        cells[i] = QuadrantCell();
+    }
+    int cell = 0;
+    for(const char* c = text; *c != '\0'; c++){
+        switch(*c){
+            case ',': cell++; break;
+            case 'N': cells[cell].walls |= 1; break;
+            case 'E': cells[cell].walls |= 2; break;
+            case 'S': cells[cell].walls |= 4; break;
+            case 'W': cells[cell].walls |= 8; break;
+            case 'R': case 'G': case 'B': case 'Y': case 'M': cells[cell].color = *c; break;
+            case 'C': cells[cell].symbol = '&'; break;
+            case 'T': cells[cell].symbol = '#'; break;
+            case 'Q': cells[cell].symbol = '%'; break;
+            case 'H': cells[cell].symbol = '$'; break;
+            case 'V': cells[cell].symbol = '*'; break;
+            default: break;
+        }
+    }
+    cells[QUADRANT_CELLS - 1].central = true;
+    for(int y = 0; y < QUADRANT_SIZE; y++){
+        for(int x = 0; x < QUADRANT_SIZE; x++){
+            int i = y * QUADRANT_SIZE + x;
+            if(x + 1 < QUADRANT_SIZE && (cells[i].walls & 2)) cells[i + 1].walls |= 8;
+            if(x > 0 && (cells[i].walls & 8)) cells[i - 1].walls |= 2;
+            if(y + 1 < QUADRANT_SIZE && (cells[i].walls & 4)) cells[i + QUADRANT_SIZE].walls |= 1;
+            if(y > 0 && (cells[i].walls & 1)) cells[i - QUADRANT_SIZE].walls |= 4;
+        }
+    }
+}
+
+/**
+ * @brief The buildQuadrantTable function parses every quarter and turns it for the 4 places of the board.
+ * @details A quarter turn clockwise sends the cell (x, y) to (QUADRANT_SIZE - 1 - y, x) and each wall to the next side (top to right, right to bottom...).
+ *
+ * @return QuadrantTable
+ */
+constexpr QuadrantTable buildQuadrantTable(){
+    QuadrantTable table;
+    for(int piece = 0; piece < QUADRANT_PIECES; piece++){
+        for(int side = 0; side < QUADRANT_SIDES; side++){
+            parseQuadrant(QUADRANT_LAYOUTS[piece][side], table.cells[piece][side][0]);
+            for(int rotation = 1; rotation < 4; rotation++){
+                const QuadrantCell* from = table.cells[piece][side][rotation - 1];
+                QuadrantCell* to = table.cells[piece][side][rotation];
+                for(int y = 0; y < QUADRANT_SIZE; y++){
+                    for(int x = 0; x < QUADRANT_SIZE; x++){
+                        QuadrantCell cell = from[y * QUADRANT_SIZE + x];
+                        cell.walls = ((cell.walls << 1) | (cell.walls >> 3)) & 15;
+                        to[x * QUADRANT_SIZE + (QUADRANT_SIZE - 1 - y)] = cell;
+                    }
+                }
+            }
+        }
+    }
+    return table;
+}
+
+/**
+ * The quarters of the original game, computed once by the compiler.
+ */
+constexpr QuadrantTable QUADRANTS = buildQuadrantTable();
+
+static_assert(QUADRANTS.cells[0][0][0][QUADRANT_CELLS - 1].walls == 9, "the central square is at the bottom right of a quarter");
+static_assert(QUADRANTS.cells[0][0][1][QUADRANT_SIZE * (QUADRANT_SIZE - 1)].walls == 3, "a quarter turn sends the bottom right cell to the bottom left");
+static_assert(QUADRANTS.cells[3][1][3][0].color == ' ', "cells without a target have no color");
+static_assert(QUADRANTS.cells[3][0][0][2 * QUADRANT_SIZE + 3].color == 'M' && QUADRANTS.cells[3][1][0][2 * QUADRANT_SIZE + 4].color == 'M', "the last quarter has the vortex on both sides");
+
+#endif // QUADRANTS_H
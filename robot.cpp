@@ -15,6 +15,7 @@
 
 /**
  * @brief Construct a new Robot:: Robot object
+ * @details The robot is not on any board until setBoard is called. Boards are owned by whoever creates them (main for the game), robots only point to them.
  * 
  */
 Robot::Robot(){
@@ -22,8 +23,7 @@ Robot::Robot(){
     this->number = 0;
     this->positionX = 0;
     this->positionY = 0;
-    this->tile = new Tile();
-    this->board = new Board();
+    this->board = nullptr;
 }
 
 /**
@@ -33,15 +33,13 @@ Robot::Robot(){
  * @param n Number of the robot
  * @param x X position of the robot
  * @param y Y position of the robot
- * @param t Tile of the robot
  * @param b Board of the robot
  */
-Robot::Robot(char c, int n, int x, int y, Tile* t, Board* b){
+Robot::Robot(char c, int n, int x, int y, Board* b){
     this->color = c;
     this->number = n;
     this->positionX = x;
     this->positionY = y;
-    this->tile = t;
     this->board = b;
 }
 
@@ -82,12 +80,31 @@ int Robot::getBasePositionY(){
 }
 
 /**
- * @brief The getTile function returns the tile of the robot
+ * @brief The getTile function returns the tile the robot currently stands on, as recorded by the board
  * 
- * @return Tile* 
+ * @return Tile*, or nullptr if the robot is not on the board
  */
 Tile* Robot::getTile(){
-    return this->tile;
+    if(this->board == nullptr){
+        return nullptr;
+    }
+    int cell = this->board->cellOf(this->number);
+    if(cell == -1){
+        return nullptr;
+    }
+    return this->board->getTile(cell % X_SIZE, cell / X_SIZE);
+}
+
+/**
+ * @brief The getCell function returns the cell the robot currently stands on, as recorded by the board
+ * 
+ * @return int, or -1 if the robot is not on the board
+ */
+int Robot::getCell(){
+    if(this->board == nullptr){
+        return -1;
+    }
+    return this->board->cellOf(this->number);
 }
 
 /**
@@ -135,15 +152,6 @@ void Robot::setBasePositionY(int y){
     this->positionY = y;
 }
 
-/**
- * @brief The setTile function sets the tile of the robot
- * 
- * @param t 
- */
-void Robot::setTile(Tile* t){
-    this->tile = t;
-}
-
 /**
  * @brief The setBoard function sets the board of the robot
  * 
@@ -155,64 +163,30 @@ void Robot::setBoard(Board* b){
 
 /**
  * @brief The moveRobot function moves the robot in the direction given
+ * @details The stop is computed by the board (stop table, or trajectory table on a board with deflectors) and trimmed to the nearest robot in the way, then the board moves the robot. The base position of the robot is not changed.
  * 
- * @param direction 
+ * @param direction 'N', 'E', 'S' or 'W'
  */
 void Robot::moveRobot(char direction){ 
-    int currentX = this->positionX;
-    int currentY = this->positionY;
-    if(direction == 'N'){
-        //check if the robot is on the top row or if there is a robot or a wall above it to prevent it from moving at all
-        if(this->positionY == 0 || this->board->getTile(this->positionX, this->positionY-1)->checkHasRobot() || this->board->getTile(this->positionX, this->positionY)->checkHasTopWall())return;
-        for(int i = this->positionY; i >= 0; i--){
-            if(this->board->getTile(this->positionX, i)->checkHasTopWall() || this->board->getTile(this->positionX, i-1)->checkHasRobot()){
-                this->positionY = i;
-                this->board->getTile(this->positionX, i)->setHasRobot(true);
-                this->setTile(this->board->getTile(this->positionX, i));
-                this->board->getTile(this->positionX, i)->setRobotColor(this->getColor());
-                this->board->getTile(currentX, currentY)->setHasRobot(false);
-                log(LogLevel::INFO, "Robot moved to tile: " + to_string(this->positionX) + ", " + to_string(this->positionY));
-                break;             
-            }
-        }
-    }else if(direction == 'S'){
-        if(this->positionY == 15 || this->board->getTile(this->positionX, this->positionY+1)->checkHasRobot() || this->board->getTile(this->positionX, this->positionY)->checkHasBottomWall())return;
-        for(int i = this->positionY; i < 16; i++){
-            if(this->board->getTile(this->positionX, i)->checkHasBottomWall() || this->board->getTile(this->positionX, i+1)->checkHasRobot()){
-                this->positionY = i;
-                this->board->getTile(this->positionX, i)->setHasRobot(true);
-                this->setTile(this->board->getTile(this->positionX, i));
-                this->board->getTile(this->positionX, i)->setRobotColor(this->getColor());
-                this->board->getTile(currentX, currentY)->setHasRobot(false);
-                log(LogLevel::INFO, "Robot moved to tile: " + to_string(this->positionX) + ", " + to_string(this->positionY));
-                break;             
-            }
-        }
-    }else if(direction == 'E'){
-        if(this->positionX == 15 || this->board->getTile(this->positionX+1, this->positionY)->checkHasRobot() || this->board->getTile(this->positionX, this->positionY)->checkHasRightWall())return;
-        for(int i = this->positionX; i < 16; i++){
-            if(this->board->getTile(i, this->positionY)->checkHasRightWall() || this->board->getTile(i+1, this->positionY)->checkHasRobot()){
-                this->positionX = i;
-                this->board->getTile(i, this->positionY)->setHasRobot(true);
-                this->setTile(this->board->getTile(i, this->positionY));
-                this->board->getTile(i, this->positionY)->setRobotColor(this->getColor());
-                this->board->getTile(currentX, currentY)->setHasRobot(false);
-                log(LogLevel::INFO, "Robot moved to tile: " + to_string(this->positionX) + ", " + to_string(this->positionY));
-                break;             
-            }
-        }
-    }else if(direction == 'W'){
-        if(this->positionX == 0 || this->board->getTile(this->positionX-1, this->positionY)->checkHasRobot() || this->board->getTile(this->positionX, this->positionY)->checkHasLeftWall())return;
-        for(int i = this->positionX; i >= 0; i--){
-            if(this->board->getTile(i, this->positionY)->checkHasLeftWall() || this->board->getTile(i-1, this->positionY)->checkHasRobot()){
-                this->positionX = i;
-                this->board->getTile(i, this->positionY)->setHasRobot(true);
-                this->setTile(this->board->getTile(i, this->positionY));
-                this->board->getTile(i, this->positionY)->setRobotColor(this->getColor());
-                this->board->getTile(currentX, currentY)->setHasRobot(false);
-                log(LogLevel::INFO, "Robot moved to tile: " + to_string(this->positionX) + ", " + to_string(this->positionY));
-                break;             
-            }
-        }
+    int d;
+    switch(direction){
+        case 'N': d = 0; break;
+        case 'E': d = 1; break;
+        case 'S': d = 2; break;
+        case 'W': d = 3; break;
+        default:
+            log(LogLevel::ERROR, "Unknown direction: " + string(1, direction));
+            return;
+    }
+    if(this->board == nullptr){
+        log(LogLevel::ERROR, "The robot is not on a board");
+        return;
+    }
+    int cell = this->board->cellOf(this->number);
+    int stop = this->board->slide(this->number, d);
+    if(stop == cell){
+        return;
     }
+    this->board->move(this->number, stop);
+    log(LogLevel::INFO, "Robot moved to tile: " + to_string(stop % X_SIZE) + ", " + to_string(stop / X_SIZE));
 }
\ No newline at end of file
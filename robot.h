@@ -15,9 +15,16 @@
 #include "tile.h"
 #include "board.h"
 
+/**
+ * The colors of the robots, in the order of their numbers: red, blue, green, yellow and silver.
+ */
+const char ROBOT_COLORS[] = {'R', 'B', 'G', 'Y', 'S'};
+static_assert(ROBOT_COUNT <= sizeof(ROBOT_COLORS), "each robot needs its own color in ROBOT_COLORS, add one for more robots");
+
 /**
  * @brief The Robot class represents a single robot on the game board.
- * @details There are 4 robots in total, each with a different color. Each robot will have a position on the game board, which is represented by the tile that the robot is on.
+ * @details There are ROBOT_COUNT robots in total (4 on the classic board), each with a different color taken in order from ROBOT_COLORS. Each robot will have a position on the game board, which is represented by the tile that the robot is on.
+ * The current position of the robot is owned by the board (see Board::cellOf); the robot only keeps its base position, where it goes back when the robots are reset.
  */
 class Robot{
     private:
@@ -25,23 +32,22 @@ class Robot{
         int number;
         int positionX;
         int positionY;
-        Tile *tile;
         Board *board;
 
     public:
         Robot();
-        Robot(char c, int n, int x, int y, Tile* t, Board* b);
+        Robot(char c, int n, int x, int y, Board* b);
         int getColor();
         int getNumber();
         int getBasePositionX();
         int getBasePositionY();
         Tile* getTile();
+        int getCell();
         Board* getBoard();
         void setColor(char c);
         void setNumber(int n);
         void setBasePositionX(int x);
         void setBasePositionY(int y);
-        void setTile(Tile* t);
         void setBoard(Board* b);
         void moveRobot(char direction);
         void checkWallCollision();
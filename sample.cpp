@@ -0,0 +1,92 @@
+/**
+ * @file sample.cpp
+ * @author Bastien
+ * @brief Functions for the reproducible rounds used to measure and check the solvers (Implementation File)
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+#include "sample.h"
+#include "quadrants.h"
+
+/**
+ * @brief The sampleBoard function lays out a board that only depends on the generator: an official board on 16x16, walls put at random otherwise
+ * @details Board::initializeBoard draws its walls from a random device, so it cannot give the same board twice.
+ *
+ * @param board
+ * @param gen
+ */
+void sampleBoard(Board* board, mt19937& gen){
+    if(board->assembleClassicBoard(uniform_int_distribution<int>(0, CLASSIC_BOARD_COUNT - 1)(gen))){
+        return;
+    }
+    board->clear();
+    uniform_int_distribution<int> xDist(0, X_SIZE - 1);
+    uniform_int_distribution<int> yDist(0, Y_SIZE - 1);
+    uniform_int_distribution<int> sideDist(0, 3);
+    for(int i = 0; i < CELL_COUNT / 16 * SAMPLE_WALLS_PER_16_CELLS; i++){
+        int x = xDist(gen);
+        int y = yDist(gen);
+        int side = sideDist(gen);
+        // The walls on the edges are always there
+        if((side == 0 && y > 0) || (side == 1 && x < X_SIZE - 1) || (side == 2 && y < Y_SIZE - 1) || (side == 3 && x > 0)){
+            board->setWall(x, y, side, true);
+        }
+    }
+}
+
+/**
+ * @brief The sampleDeflectorBoard function lays out a board of sampleBoard and adds the diagonal deflectors of the variant, also drawn from the generator
+ *
+ * @param board
+ * @param gen
+ */
+void sampleDeflectorBoard(Board* board, mt19937& gen){
+    sampleBoard(board, gen);
+    board->placeDeflectors(SAMPLE_DEFLECTOR_COUNT, gen);
+}
+
+/**
+ * @brief The sampleRound function draws a round on a board: the robots on distinct cells out of the central tiles and the deflectors, and a target
+ * @details On a board with targets, one of them is drawn and the robot of its color has to reach it, any robot for the multicolored one. Otherwise the target is any cell, to be reached by any robot one round in four.
+ *
+ * @param board
+ * @param gen
+ * @return SampleRound
+ */
+SampleRound sampleRound(Board* board, mt19937& gen){
+    uniform_int_distribution<int> cellDist(0, CELL_COUNT - 1);
+    int cells[ROBOT_COUNT];
+    for(int i = 0; i < ROBOT_COUNT; i++){
+        bool taken;
+        do{
+            cells[i] = cellDist(gen);
+            Tile* tile = board->getTile(cells[i] % X_SIZE, cells[i] / X_SIZE);
+            taken = tile->checkIsCentralTile() || tile->getDeflector() != ' ';
+            for(int j = 0; j < i; j++){
+                taken |= cells[j] == cells[i];
+            }
+        }while(taken);
+    }
+    SampleRound round;
+    round.start = Solver::packState(cells);
+    round.targetRobot = -1;
+    if(board->getTargetCount() > 0){
+        Tile* target = board->getTarget(uniform_int_distribution<int>(0, board->getTargetCount() - 1)(gen));
+        round.targetCell = board->getCell(target);
+        for(int i = 0; i < ROBOT_COUNT; i++){
+            if(ROBOT_COLORS[i] == target->getTargetColor()){
+                round.targetRobot = i;
+            }
+        }
+    }else{
+        round.targetCell = cellDist(gen);
+        if(uniform_int_distribution<int>(0, 3)(gen) != 0){
+            round.targetRobot = uniform_int_distribution<int>(0, ROBOT_COUNT - 1)(gen);
+        }
+    }
+    return round;
+}
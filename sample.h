@@ -0,0 +1,41 @@
+/**
+ * @file sample.h
+ * @author Bastien
+ * @brief Functions for the reproducible rounds used to measure and check the solvers
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+#ifndef SAMPLE_H
+#define SAMPLE_H
+
+#include "solver.h"
+#include <random>
+
+/**
+ * The number of walls put at random on a board that is not 16x16, for each 16 cells (a classic board has about one for 8 cells, counting the edges).
+ */
+const int SAMPLE_WALLS_PER_16_CELLS = 1;
+
+/**
+ * The number of deflectors put on a board by sampleDeflectorBoard, as many as the 'd' key of the game puts.
+ */
+const int SAMPLE_DEFLECTOR_COUNT = 8;
+
+/**
+ * @brief A round to solve: the cells of the robots, the target and the robot that has to reach it.
+ */
+struct SampleRound{
+    State start;
+    int targetCell;
+    int targetRobot;
+};
+
+void sampleBoard(Board* board, mt19937& gen);
+void sampleDeflectorBoard(Board* board, mt19937& gen);
+SampleRound sampleRound(Board* board, mt19937& gen);
+
+#endif // SAMPLE_H
@@ -0,0 +1,529 @@
+/**
+ * @file snapshot.cpp
+ * @author Bastien
+ * @brief Classes for board snapshots and robot states (Implementation File)
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+#include "snapshot.h"
+#include <algorithm>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define SNAPSHOT_X86
+#endif
+
+const State CELL_MASK = ((State)1 << Board::CELL_BITS) - 1;
+
+/**
+ * @brief Construct a new RobotState:: RobotState object with all robots on cell 0
+ *
+ */
+RobotState::RobotState(){
+    this->state = 0;
+}
+
+/**
+ * @brief Construct a new RobotState:: RobotState object from a packed state
+ *
+ * @param s
+ */
+RobotState::RobotState(State s){
+    this->state = s;
+}
+
+/**
+ * @brief Construct a new RobotState:: RobotState object from the cell of each robot
+ *
+ * @param cells
+ */
+RobotState::RobotState(const int cells[ROBOT_COUNT]){
+    this->state = 0;
+    for(int i = 0; i < ROBOT_COUNT; i++){
+        this->state |= (State)cells[i] << (Board::CELL_BITS * i);
+    }
+}
+
+/**
+ * @brief The getState function returns the packed state
+ *
+ * @return State
+ */
+State RobotState::getState() const{
+    return this->state;
+}
+
+/**
+ * @brief The cellOf function returns the cell of a robot
+ *
+ * @param robot
+ * @return int
+ */
+int RobotState::cellOf(int robot) const{
+    return (this->state >> (Board::CELL_BITS * robot)) & CELL_MASK;
+}
+
+/**
+ * @brief The robotAt function returns the robot standing on a cell
+ *
+ * @param cell
+ * @return The number of the robot, or -1 if the cell is empty
+ */
+int RobotState::robotAt(int cell) const{
+    for(int i = 0; i < ROBOT_COUNT; i++){
+        if(this->cellOf(i) == cell){
+            return i;
+        }
+    }
+    return -1;
+}
+
+/**
+ * @brief The move function moves a robot to a cell
+ *
+ * @param robot
+ * @param to
+ */
+void RobotState::move(int robot, int to){
+    this->state = (this->state & ~((State)CELL_MASK << (Board::CELL_BITS * robot))) | ((State)to << (Board::CELL_BITS * robot));
+}
+
+/**
+ * @brief Construct a new BoardSnapshot:: BoardSnapshot object
+ *
+ * @param w The walls of each cell (1 = top, 2 = right, 4 = bottom, 8 = left)
+ * @param s The stop table of the board
+ * @param t The targets of the board
+ * @param paths The trajectory table of the board, or nullptr if it has no deflectors
+ * @param colors The color of each robot
+ */
+BoardSnapshot::BoardSnapshot(const unsigned char w[CELL_COUNT], const Cell s[CELL_COUNT][4], const vector<SnapshotTarget>& t, shared_ptr<const TrajectoryTable> paths, const char colors[ROBOT_COUNT]){
+    for(int cell = 0; cell < CELL_COUNT; cell++){
+        this->walls[cell] = w[cell];
+        for(int direction = 0; direction < 4; direction++){
+            this->stops[cell][direction] = s[cell][direction];
+        }
+    }
+    this->targets = t;
+    this->trajectories = paths;
+    for(int i = 0; i < ROBOT_COUNT; i++){
+        this->robotColors[i] = TrajectoryTable::colorIndex(colors[i]);
+    }
+
+    // One group per path color: a single one without deflectors
+    this->groupCount = 0;
+    for(int i = 0; i < ROBOT_COUNT; i++){
+        int group = 0;
+        while(group < this->groupCount && this->trajectories && this->groupColors[group] != this->robotColors[i]){
+            group++;
+        }
+        if(group == this->groupCount){
+            this->groupColors[this->groupCount++] = this->robotColors[i];
+        }
+        this->robotGroups[i] = group;
+    }
+
+    // Every cell a robot can stop on in one move if it may stop anywhere on its path, stored backwards (from the cell reached to the starting cell)
+    vector<int> path;
+    auto forEachMove = [&](int group, auto add){
+        for(int cell = 0; cell < CELL_COUNT; cell++){
+            for(int direction = 0; direction < 4; direction++){
+                this->getGroupPath(group, cell, direction, path);
+                for(int to : path){
+                    add(cell, to);
+                }
+            }
+        }
+    };
+    // Count the moves ending on each cell, then turn the counts into offsets
+    this->predecessorStarts.assign(this->groupCount * (CELL_COUNT + 1), 0);
+    for(int group = 0; group < this->groupCount; group++){
+        uint32_t* starts = &this->predecessorStarts[group * (CELL_COUNT + 1)];
+        forEachMove(group, [&](int, int to){ starts[to + 1]++; });
+        starts[0] = group == 0 ? 0 : starts[-1];
+        for(int cell = 0; cell < CELL_COUNT; cell++){
+            starts[cell + 1] += starts[cell];
+        }
+    }
+    this->predecessors.resize(this->predecessorStarts.back());
+    vector<uint32_t> ends(this->predecessorStarts);
+    for(int group = 0; group < this->groupCount; group++){
+        uint32_t* next = &ends[group * (CELL_COUNT + 1)];
+        forEachMove(group, [&](int from, int to){ this->predecessors[next[to]++] = from; });
+    }
+
+    // The hash covers everything the paths and the targets depend on: walls, targets and, with deflectors, every path of every group
+    this->hash = 1469598103934665603ull;
+    auto mix = [&](uint64_t value){
+        this->hash = (this->hash ^ value) * 1099511628211ull;
+    };
+    mix(CELL_COUNT);
+    for(int cell = 0; cell < CELL_COUNT; cell++){
+        mix(this->walls[cell]);
+    }
+    for(int i = 0; i < this->targets.size(); i++){
+        mix(this->targets[i].cell);
+        mix(this->targets[i].color);
+    }
+    if(this->trajectories){
+        for(int group = 0; group < this->groupCount; group++){
+            mix(this->groupColors[group]);
+            forEachMove(group, [&](int, int to){ mix(to); });
+        }
+    }
+
+    this->distances.resize(this->targets.size() * this->groupCount * CELL_COUNT);
+    for(int i = 0; i < this->targets.size(); i++){
+        for(int group = 0; group < this->groupCount; group++){
+            this->computeGroupDistances(this->targets[i].cell, group, &this->distances[(i * this->groupCount + group) * CELL_COUNT]);
+        }
+    }
+}
+
+/**
+ * @brief The hasWall function checks if a cell has a wall on one side
+ *
+ * @param cell
+ * @param direction 0 = N, 1 = E, 2 = S, 3 = W
+ * @return true
+ * @return false
+ */
+bool BoardSnapshot::hasWall(int cell, int direction) const{
+    return this->walls[cell] & (1 << direction);
+}
+
+/**
+ * @brief The getStop function returns the cell where a robot stops from a cell in a direction, counting only the walls
+ *
+ * @param cell
+ * @param direction 0 = N, 1 = E, 2 = S, 3 = W
+ * @return int
+ */
+int BoardSnapshot::getStop(int cell, int direction) const{
+    return this->stops[cell][direction];
+}
+
+/**
+ * @brief The slide function returns the cell where a robot stops when it moves in a direction, counting the walls, the deflectors and the other robots
+ * @details Same rules as Board::slide.
+ *
+ * @param robots The cells of the robots
+ * @param robot The robot to move
+ * @param direction 0 = N, 1 = E, 2 = S, 3 = W
+ * @return int
+ */
+int BoardSnapshot::slide(const RobotState& robots, int robot, int direction) const{
+    int cell = robots.cellOf(robot);
+    int stop = this->stops[cell][direction];
+    if(this->trajectories){
+        const Trajectory& path = this->trajectories->get(this->robotColors[robot], cell, direction);
+        if(path.bent){
+            for(int i = 0; i < path.length; i++){
+                if(robots.robotAt(this->trajectories->getCell(path, i)) != -1){
+                    return i == 0 ? cell : this->trajectories->getCell(path, i - 1);
+                }
+            }
+            return this->trajectories->getEnd(path, cell);
+        }
+        stop = this->trajectories->getEnd(path, cell);
+    }
+    for(int i = 0; i < ROBOT_COUNT; i++){
+        stop = Board::trimStop(cell, direction, stop, robots.cellOf(i));
+    }
+    return stop;
+}
+
+#ifdef SNAPSHOT_X86
+/**
+ * @brief Expands 8 states of a 16x16 board with 32-bit states in the lanes of AVX2 registers
+ * @details One gather per robot reads the 4 stops of its cell at once (one byte per direction). Each stop is then shortened by the other robots standing between the robot and the stop: the nearest one gives the highest (north, west) or the lowest (east, south) cell, so the blockers are reduced with a max or a min. The successors are written state by state, MOVE_COUNT each.
+ *
+ * @param stops The stop table of the snapshot
+ * @param states The EXPAND_BATCH_SIZE states
+ * @param successors The successors
+ */
+__attribute__((target("avx2"))) static void expandAvx2(const Cell stops[CELL_COUNT][4], const State* states, State* successors){
+    const __m256i cellMask = _mm256_set1_epi32(0xFF);
+    const __m256i columnMask = _mm256_set1_epi32(X_SIZE - 1);
+    const __m256i row = _mm256_set1_epi32(X_SIZE);
+    const __m256i one = _mm256_set1_epi32(1);
+    __m256i packed = _mm256_loadu_si256((const __m256i*)states);
+    __m256i cells[ROBOT_COUNT];
+    for(int robot = 0; robot < ROBOT_COUNT; robot++){
+        cells[robot] = _mm256_and_si256(_mm256_srli_epi32(packed, robot * 8), cellMask);
+    }
+    alignas(32) State moves[MOVE_COUNT][EXPAND_BATCH_SIZE];
+    for(int robot = 0; robot < ROBOT_COUNT; robot++){
+        __m256i cell = cells[robot];
+        __m256i column = _mm256_and_si256(cell, columnMask);
+        __m256i allStops = _mm256_i32gather_epi32((const int*)stops, cell, 4);
+        __m256i others = _mm256_andnot_si256(_mm256_slli_epi32(cellMask, robot * 8), packed);
+        for(int direction = 0; direction < 4; direction++){
+            __m256i stop = _mm256_and_si256(_mm256_srli_epi32(allStops, direction * 8), cellMask);
+            for(int other = 0; other < ROBOT_COUNT; other++){
+                if(other == robot) continue;
+                __m256i blocker = cells[other];
+                __m256i before = _mm256_cmpgt_epi32(cell, blocker);
+                __m256i after = _mm256_cmpgt_epi32(blocker, cell);
+                __m256i sameColumn = _mm256_cmpeq_epi32(_mm256_and_si256(blocker, columnMask), column);
+                switch(direction){
+                    case 0: {
+                        __m256i between = _mm256_and_si256(_mm256_andnot_si256(_mm256_cmpgt_epi32(stop, blocker), before), sameColumn);
+                        stop = _mm256_max_epi32(stop, _mm256_blendv_epi8(stop, _mm256_add_epi32(blocker, row), between));
+                        break;
+                    }
+                    case 1: {
+                        __m256i between = _mm256_andnot_si256(_mm256_cmpgt_epi32(blocker, stop), after);
+                        stop = _mm256_min_epi32(stop, _mm256_blendv_epi8(stop, _mm256_sub_epi32(blocker, one), between));
+                        break;
+                    }
+                    case 2: {
+                        __m256i between = _mm256_and_si256(_mm256_andnot_si256(_mm256_cmpgt_epi32(blocker, stop), after), sameColumn);
+                        stop = _mm256_min_epi32(stop, _mm256_blendv_epi8(stop, _mm256_sub_epi32(blocker, row), between));
+                        break;
+                    }
+                    default: {
+                        __m256i between = _mm256_andnot_si256(_mm256_cmpgt_epi32(stop, blocker), before);
+                        stop = _mm256_max_epi32(stop, _mm256_blendv_epi8(stop, _mm256_add_epi32(blocker, one), between));
+                        break;
+                    }
+                }
+            }
+            _mm256_store_si256((__m256i*)moves[robot * 4 + direction], _mm256_or_si256(others, _mm256_slli_epi32(stop, robot * 8)));
+        }
+    }
+    for(int i = 0; i < EXPAND_BATCH_SIZE; i++){
+        for(int move = 0; move < MOVE_COUNT; move++){
+            successors[i * MOVE_COUNT + move] = moves[move][i];
+        }
+    }
+}
+#endif
+
+/**
+ * @brief The expand function computes every successor of a batch of states
+ * @details successors[i * MOVE_COUNT + robot * 4 + direction] is the state reached from states[i] by moving the robot in the direction, or states[i] itself when the robot cannot move. On a 16x16 board with 32-bit states and no deflectors the states are expanded 8 at a time with AVX2 when the processor supports it, the others (and the rest of the batch) one robot at a time with slide.
+ *
+ * @param states The states to expand
+ * @param count The number of states
+ * @param successors The successors, count * MOVE_COUNT of them
+ */
+void BoardSnapshot::expand(const State* states, int count, State* successors) const{
+    int i = 0;
+#ifdef SNAPSHOT_X86
+    if constexpr(X_SIZE == 16 && Y_SIZE == 16 && sizeof(State) == 4 && sizeof(Cell) == 1){
+        if(!this->trajectories && __builtin_cpu_supports("avx2")){
+            for(; i + EXPAND_BATCH_SIZE <= count; i += EXPAND_BATCH_SIZE){
+                expandAvx2(this->stops, states + i, successors + i * MOVE_COUNT);
+            }
+        }
+    }
+#endif
+    for(; i < count; i++){
+        RobotState robots(states[i]);
+        for(int robot = 0; robot < ROBOT_COUNT; robot++){
+            for(int direction = 0; direction < 4; direction++){
+                RobotState next = robots;
+                next.move(robot, this->slide(robots, robot, direction));
+                successors[i * MOVE_COUNT + robot * 4 + direction] = next.getState();
+            }
+        }
+    }
+}
+
+/**
+ * @brief The hasDeflectors function checks if the board has diagonal deflectors
+ * @details The reverse moves (getReversePath and unslide) only follow straight paths, so they are only valid without deflectors.
+ *
+ * @return true
+ * @return false
+ */
+bool BoardSnapshot::hasDeflectors() const{
+    return this->trajectories != nullptr;
+}
+
+/**
+ * @brief The getReversePath function returns the cells from which a robot moving in a direction goes through a cell, counting only the walls
+ *
+ * @param cell
+ * @param direction The direction of the move, 0 = N, 1 = E, 2 = S, 3 = W
+ * @param cells The cells, nearest first
+ */
+void BoardSnapshot::getReversePath(int cell, int direction, vector<int>& cells) const{
+    const int steps[4] = {-X_SIZE, 1, X_SIZE, -1};
+    cells.clear();
+    for(int from = cell; !this->hasWall(from, (direction + 2) % 4);){
+        from -= steps[direction];
+        cells.push_back(from);
+    }
+}
+
+/**
+ * @brief The unslide function returns the cells a robot can have come from when its last move was in a direction
+ * @details The robot must be stopped in that direction, by a wall or by another robot, and it came from a cell of the reverse path that no other robot stands on or before. The other robots did not move, so they block the same way before and after the move. Only valid on a board without deflectors.
+ *
+ * @param robots The cells of the robots after the move
+ * @param robot The robot that moved
+ * @param direction The direction of the move, 0 = N, 1 = E, 2 = S, 3 = W
+ * @param cells The cells the robot can have come from, nearest first
+ */
+void BoardSnapshot::unslide(const RobotState& robots, int robot, int direction, vector<int>& cells) const{
+    const int steps[4] = {-X_SIZE, 1, X_SIZE, -1};
+    int cell = robots.cellOf(robot);
+    cells.clear();
+    if(!this->hasWall(cell, direction) && robots.robotAt(cell + steps[direction]) == -1){
+        return;
+    }
+    this->getReversePath(cell, direction, cells);
+    for(int i = 0; i < cells.size(); i++){
+        if(robots.robotAt(cells[i]) != -1){
+            cells.resize(i);
+            break;
+        }
+    }
+}
+
+/**
+ * @brief The getTargetCount function returns the number of targets
+ *
+ * @return int
+ */
+int BoardSnapshot::getTargetCount() const{
+    return this->targets.size();
+}
+
+/**
+ * @brief The getTarget function returns a target
+ *
+ * @param i The index of the target, in the same order as Board::getTarget
+ * @return SnapshotTarget
+ */
+SnapshotTarget BoardSnapshot::getTarget(int i) const{
+    return this->targets[i];
+}
+
+/**
+ * @brief The findTarget function returns the index of the target on a cell
+ *
+ * @param cell
+ * @return The index of the target, or -1 if there is no target on the cell
+ */
+int BoardSnapshot::findTarget(int cell) const{
+    for(int i = 0; i < this->targets.size(); i++){
+        if(this->targets[i].cell == cell){
+            return i;
+        }
+    }
+    return -1;
+}
+
+/**
+ * @brief The getPathGroup function returns the group of a robot: robots of the same group follow the same paths
+ *
+ * @param robot
+ * @return int
+ */
+int BoardSnapshot::getPathGroup(int robot) const{
+    return this->robotGroups[robot];
+}
+
+/**
+ * @brief The getPath function returns the cells a robot crosses when it moves in a direction, counting only the walls and the deflectors
+ * @details Any of these cells can be where the robot stops, if the next one holds another robot.
+ *
+ * @param robot
+ * @param cell The starting cell
+ * @param direction 0 = N, 1 = E, 2 = S, 3 = W
+ * @param path The cells, in order and without the starting cell
+ */
+void BoardSnapshot::getPath(int robot, int cell, int direction, vector<int>& path) const{
+    this->getGroupPath(this->robotGroups[robot], cell, direction, path);
+}
+
+/**
+ * @brief The getGroupPath function returns the cells a robot of a group crosses when it moves in a direction, see getPath
+ *
+ * @param group
+ * @param cell
+ * @param direction
+ * @param path
+ */
+void BoardSnapshot::getGroupPath(int group, int cell, int direction, vector<int>& path) const{
+    const int steps[4] = {-X_SIZE, 1, X_SIZE, -1};
+    path.clear();
+    if(this->trajectories){
+        const Trajectory& trajectory = this->trajectories->get(this->groupColors[group], cell, direction);
+        for(int i = 0; i < trajectory.length; i++){
+            path.push_back(this->trajectories->getCell(trajectory, i));
+        }
+        return;
+    }
+    for(int to = cell; to != this->stops[cell][direction];){
+        to += steps[direction];
+        path.push_back(to);
+    }
+}
+
+/**
+ * @brief The getHash function returns a hash of the walls, the targets and the deflectors of the board
+ * @details Two snapshots with the same hash have the same paths and the same distance maps, so results computed for one of them can be saved and used again for the other.
+ *
+ * @return uint64_t
+ */
+uint64_t BoardSnapshot::getHash() const{
+    return this->hash;
+}
+
+/**
+ * @brief The getDistance function returns a lower bound of the number of moves a robot needs to reach a target
+ *
+ * @param target The index of the target
+ * @param robot
+ * @param cell The cell of the robot
+ * @return The number of moves if the robot could stop anywhere on its path, or UNREACHABLE
+ */
+int BoardSnapshot::getDistance(int target, int robot, int cell) const{
+    return this->distances[(target * this->groupCount + this->robotGroups[robot]) * CELL_COUNT + cell];
+}
+
+/**
+ * @brief The computeDistances function computes the distance map of a robot to any cell, as stored for the targets
+ *
+ * @param cell The cell to reach
+ * @param robot
+ * @param distances The lower bound of the number of moves from each cell, or UNREACHABLE
+ */
+void BoardSnapshot::computeDistances(int cell, int robot, vector<unsigned char>& distances) const{
+    distances.resize(CELL_COUNT);
+    this->computeGroupDistances(cell, this->robotGroups[robot], distances.data());
+}
+
+/**
+ * @brief The computeGroupDistances function runs a breadth-first search backwards from a cell over the relaxed moves of a group of robots
+ *
+ * @param cell The cell to reach
+ * @param group
+ * @param distances CELL_COUNT distances, filled by the search
+ */
+void BoardSnapshot::computeGroupDistances(int cell, int group, unsigned char* distances) const{
+    const uint32_t* starts = &this->predecessorStarts[group * (CELL_COUNT + 1)];
+    vector<Cell> queue;
+    queue.reserve(CELL_COUNT);
+    fill(distances, distances + CELL_COUNT, UNREACHABLE);
+    distances[cell] = 0;
+    queue.push_back(cell);
+    for(size_t head = 0; head < queue.size(); head++){
+        int to = queue[head];
+        for(uint32_t i = starts[to]; i < starts[to + 1]; i++){
+            int from = this->predecessors[i];
+            if(distances[from] == UNREACHABLE){
+                distances[from] = distances[to] + 1;
+                queue.push_back(from);
+            }
+        }
+    }
+}
@@ -0,0 +1,118 @@
+/**
+ * @file snapshot.h
+ * @author Bastien
+ * @brief Classes for board snapshots and robot states
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include "board.h"
+#include <cstdint>
+#include <vector>
+
+const int CELL_COUNT = X_SIZE * Y_SIZE;
+
+/**
+ * Type definition for a search state: the cells of the robots packed in one integer, Board::CELL_BITS bits per robot (robot 0 in the lowest bits).
+ * On the classic board this is one byte per robot in 32 bits. A cell is stored as y * X_SIZE + x.
+ */
+typedef Board::StateType State;
+
+/**
+ * Type definition for a cell number, as small as the board allows.
+ */
+typedef Board::Cell Cell;
+
+/**
+ * @brief A target of a snapshot: its cell, its color and its symbol.
+ */
+struct SnapshotTarget{
+    int cell;
+    char color;
+    char symbol;
+};
+
+/**
+ * @brief The RobotState class is a tiny value overlay holding the cells of the robots.
+ * @details It is a single packed State, so it can be copied, compared and thrown away freely while exploring hypothetical positions on a BoardSnapshot.
+ */
+class RobotState{
+    private:
+        State state;
+
+    public:
+        RobotState();
+        RobotState(State s);
+        RobotState(const int cells[ROBOT_COUNT]);
+        State getState() const;
+        int cellOf(int robot) const;
+        int robotAt(int cell) const;
+        void move(int robot, int to);
+};
+
+/**
+ * The distance stored for a cell from which a robot can never reach a target.
+ */
+const unsigned char UNREACHABLE = 255;
+
+/**
+ * The number of moves from a state (every robot in every direction), which is the number of successors BoardSnapshot::expand writes for each state.
+ */
+const int MOVE_COUNT = ROBOT_COUNT * 4;
+
+/**
+ * The number of states BoardSnapshot::expand handles together: one 32-bit lane of an AVX2 register for each.
+ */
+const int EXPAND_BATCH_SIZE = 8;
+
+/**
+ * @brief The BoardSnapshot class is an immutable copy of the fixed part of a board: its walls, its targets and its stop table.
+ * @details Snapshots are created by Board::getSnapshot and shared by reference (shared_ptr to const), so solvers, bots and hints can read them from any thread while the live board goes on. Robot positions are not part of the snapshot, they are given separately as a RobotState.
+ * On a board with diagonal deflectors the snapshot also shares the trajectory table of the board and keeps the color of each robot, as the path of a robot depends on it.
+ * The snapshot also holds, for every target, the distance map used as a lower bound by the solvers: the number of moves a robot needs from each cell when it may stop on any cell of its path. The other robots can only make a robot stop earlier on its path, so the real number of moves is never smaller.
+ */
+class BoardSnapshot{
+    private:
+        unsigned char walls[CELL_COUNT];
+        Cell stops[CELL_COUNT][4];
+        vector<SnapshotTarget> targets;
+        shared_ptr<const TrajectoryTable> trajectories;
+        int robotColors[ROBOT_COUNT];
+        // Robots whose paths are the same share their distance maps (all of them on a board without deflectors)
+        int groupCount;
+        int groupColors[ROBOT_COUNT];
+        int robotGroups[ROBOT_COUNT];
+        // For each group and each cell, the cells from which a robot can stop on it in one move (compressed rows)
+        vector<uint32_t> predecessorStarts;
+        vector<Cell> predecessors;
+        vector<unsigned char> distances;
+        uint64_t hash;
+        void getGroupPath(int group, int cell, int direction, vector<int>& path) const;
+        void computeGroupDistances(int cell, int group, unsigned char* distances) const;
+
+    public:
+        BoardSnapshot(const unsigned char w[CELL_COUNT], const Cell s[CELL_COUNT][4], const vector<SnapshotTarget>& t, shared_ptr<const TrajectoryTable> paths, const char colors[ROBOT_COUNT]);
+        bool hasWall(int cell, int direction) const;
+        int getStop(int cell, int direction) const;
+        int slide(const RobotState& robots, int robot, int direction) const;
+        void expand(const State* states, int count, State* successors) const;
+        bool hasDeflectors() const;
+        void getReversePath(int cell, int direction, vector<int>& cells) const;
+        void unslide(const RobotState& robots, int robot, int direction, vector<int>& cells) const;
+        int getTargetCount() const;
+        SnapshotTarget getTarget(int i) const;
+        int findTarget(int cell) const;
+        int getPathGroup(int robot) const;
+        void getPath(int robot, int cell, int direction, vector<int>& path) const;
+        uint64_t getHash() const;
+        int getDistance(int target, int robot, int cell) const;
+        void computeDistances(int cell, int robot, vector<unsigned char>& distances) const;
+};
+
+#endif // SNAPSHOT_H
@@ -0,0 +1,288 @@
+/**
+ * @file solver.cpp
+ * @author Bastien
+ * @brief Class for the solver (Implementation File)
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+#include "solver.h"
+#include "log.h"
+#include <algorithm>
+
+/**
+ * @brief Construct a new Solver:: Solver object
+ *
+ * @param b The board to solve, its current snapshot is used
+ */
+Solver::Solver(Board* b){
+    this->board = b->getSnapshot();
+}
+
+/**
+ * @brief Construct a new Solver:: Solver object
+ *
+ * @param b The snapshot of the board to solve
+ */
+Solver::Solver(shared_ptr<const BoardSnapshot> b){
+    this->board = b;
+}
+
+/**
+ * @brief The packState function packs the cells of the robots in a state
+ *
+ * @param cells The cell of each robot
+ * @return State
+ */
+State Solver::packState(const int cells[ROBOT_COUNT]){
+    return RobotState(cells).getState();
+}
+
+/**
+ * @brief The getRobotCell function returns the cell of a robot in a state
+ *
+ * @param state
+ * @param robot
+ * @return int
+ */
+int Solver::getRobotCell(State state, int robot){
+    return RobotState(state).cellOf(robot);
+}
+
+/**
+ * @brief The setRobotCell function returns the state with the cell of a robot replaced
+ *
+ * @param state
+ * @param robot
+ * @param cell
+ * @return State
+ */
+State Solver::setRobotCell(State state, int robot, int cell){
+    RobotState robots(state);
+    robots.move(robot, cell);
+    return robots.getState();
+}
+
+/**
+ * @brief The directionToChar function converts a direction index to the character used by Robot::moveRobot
+ *
+ * @param direction 0 = N, 1 = E, 2 = S, 3 = W
+ * @return char
+ */
+char Solver::directionToChar(int direction){
+    const char directions[4] = {'N', 'E', 'S', 'W'};
+    return directions[direction];
+}
+
+/**
+ * @brief The slide function computes where a robot stops when it is moved in a direction
+ * @details The robot moves until it meets a wall or another robot, following the same rules as Robot::moveRobot: the wall stop is read from the snapshot and trimmed to the nearest robot in the way.
+ *
+ * @param state The current state
+ * @param robot The robot to move
+ * @param direction 0 = N, 1 = E, 2 = S, 3 = W
+ * @return The cell where the robot stops
+ */
+int Solver::slide(State state, int robot, int direction){
+    return this->board->slide(RobotState(state), robot, direction);
+}
+
+/**
+ * @brief The solve function solves the current round
+ * @details The start state is the current placement of the robots and the goal is the objective tile. The robot matching the color of the objective tile has to reach it, or any robot if the objective tile is multicolored.
+ *
+ * @param robots The robots of the game
+ * @param objectiveTile The objective tile
+ * @return Solution
+ */
+Solution Solver::solve(Robot* robots[ROBOT_COUNT], Tile* objectiveTile){
+    int cells[ROBOT_COUNT];
+    int targetRobot = -1;
+    for(int i = 0; i < ROBOT_COUNT; i++){
+        cells[i] = robots[i]->getCell();
+        if(robots[i]->getColor() == objectiveTile->getTargetColor()){
+            targetRobot = i;
+        }
+    }
+    int targetCell = robots[0]->getBoard()->getCell(objectiveTile);
+    return this->solve(packState(cells), targetCell, targetRobot);
+}
+
+/**
+ * @brief The solve function runs a breadth-first search from a start state
+ * @details The robots that can be swapped without changing the round (see Symmetry) are sorted in every state, so each set of swapped states is only searched once. The moves are then given back for the real robots.
+ *
+ * @param start The start state
+ * @param targetCell The cell to reach
+ * @param targetRobot The robot that has to reach the cell, or -1 if any robot can reach it
+ * @return Solution
+ */
+Solution Solver::solve(State start, int targetCell, int targetRobot){
+    Solution solution;
+    solution.solved = false;
+    solution.nodes = 0;
+
+    auto isGoal = [&](State state){
+        for(int i = 0; i < ROBOT_COUNT; i++){
+            if((targetRobot == -1 || targetRobot == i) && getRobotCell(state, i) == targetCell){
+                return true;
+            }
+        }
+        return false;
+    };
+
+    // The search runs on canonical states, the swappable robots being sorted
+    Symmetry symmetry(*this->board, targetRobot);
+    State real = start;
+    start = symmetry.canonical(start);
+
+    ParentMap parents;
+    vector<State> queue;
+    parents[start] = make_pair(start, 0);
+    queue.push_back(start);
+
+    bool found = isGoal(start);
+    State goal = start;
+    // The states are expanded by batches, in queue order
+    State successors[EXPAND_BATCH_SIZE * MOVE_COUNT];
+    for(size_t head = 0; head < queue.size() && !found;){
+        int count = min(queue.size() - head, (size_t)EXPAND_BATCH_SIZE);
+        this->board->expand(&queue[head], count, successors);
+        for(int i = 0; i < count && !found; i++, head++){
+            State state = queue[head];
+            solution.nodes++;
+            for(int move = 0; move < MOVE_COUNT; move++){
+                State next = successors[i * MOVE_COUNT + move];
+                if(next == state) continue;
+                next = symmetry.canonical(next);
+                if(!parents.emplace(next, make_pair(state, (unsigned char)move)).second) continue;
+                if(isGoal(next)){
+                    found = true;
+                    goal = next;
+                    break;
+                }
+                queue.push_back(next);
+            }
+        }
+    }
+
+    if(!found){
+        log(LogLevel::DEBUG, "Solver found no solution after " + to_string(solution.nodes) + " nodes");
+        return solution;
+    }
+
+    solution = buildSolution(parents, start, goal, solution.nodes);
+    solution.moves = symmetry.mapMoves(*this->board, real, solution.moves);
+    log(LogLevel::DEBUG, "Solver found a solution in " + to_string(solution.moves.size()) + " moves after " + to_string(solution.nodes) + " nodes");
+    return solution;
+}
+
+/**
+ * @brief The solveAll function solves every target of the board from the current robot placement
+ *
+ * @param robots The robots of the game
+ * @return The solution of each target, in the same order as Board::getTarget
+ */
+vector<Solution> Solver::solveAll(Robot* robots[ROBOT_COUNT]){
+    int cells[ROBOT_COUNT];
+    char colors[ROBOT_COUNT];
+    for(int i = 0; i < ROBOT_COUNT; i++){
+        cells[i] = robots[i]->getCell();
+        colors[i] = robots[i]->getColor();
+    }
+    return this->solveAll(packState(cells), colors);
+}
+
+/**
+ * @brief The solveAll function runs a single breadth-first search from a start state and records the first time each target is reached
+ * @details A target is reached when the robot of its color (or any robot for the multicolored target) stands on it. States are expanded in breadth-first order, so the first state reaching a target is at the smallest depth and its path is an optimal solution for that target. The search stops as soon as every target is solved, or when no state is left.
+ *
+ * @param start The start state
+ * @param colors The color of each robot
+ * @return The solution of each target, in the same order as BoardSnapshot::getTarget
+ */
+vector<Solution> Solver::solveAll(State start, const char colors[ROBOT_COUNT]){
+    int targetCount = this->board->getTargetCount();
+    vector<Solution> solutions(targetCount, {false, {}, 0});
+    vector<State> goals(targetCount, start);
+
+    // The target that a robot solves by stopping on a cell, if any
+    vector<int> goalOf(CELL_COUNT * ROBOT_COUNT, -1);
+    for(int i = 0; i < targetCount; i++){
+        SnapshotTarget target = this->board->getTarget(i);
+        for(int robot = 0; robot < ROBOT_COUNT; robot++){
+            if(target.color == 'M' || target.color == colors[robot]){
+                goalOf[target.cell * ROBOT_COUNT + robot] = i;
+            }
+        }
+    }
+
+    int remaining = targetCount;
+    long long nodes = 0;
+    auto markGoals = [&](State state){
+        for(int robot = 0; robot < ROBOT_COUNT; robot++){
+            int target = goalOf[getRobotCell(state, robot) * ROBOT_COUNT + robot];
+            if(target != -1 && !solutions[target].solved){
+                solutions[target].solved = true;
+                solutions[target].nodes = nodes;
+                goals[target] = state;
+                remaining--;
+            }
+        }
+    };
+
+    ParentMap parents;
+    vector<State> queue;
+    parents[start] = make_pair(start, 0);
+    queue.push_back(start);
+    markGoals(start);
+
+    State successors[EXPAND_BATCH_SIZE * MOVE_COUNT];
+    for(size_t head = 0; head < queue.size() && remaining > 0;){
+        int count = min(queue.size() - head, (size_t)EXPAND_BATCH_SIZE);
+        this->board->expand(&queue[head], count, successors);
+        for(int i = 0; i < count && remaining > 0; i++, head++){
+            State state = queue[head];
+            nodes++;
+            for(int move = 0; move < MOVE_COUNT; move++){
+                State next = successors[i * MOVE_COUNT + move];
+                if(next == state) continue;
+                if(!parents.emplace(next, make_pair(state, (unsigned char)move)).second) continue;
+                markGoals(next);
+                queue.push_back(next);
+            }
+        }
+    }
+
+    for(int i = 0; i < targetCount; i++){
+        if(solutions[i].solved){
+            solutions[i] = buildSolution(parents, start, goals[i], solutions[i].nodes);
+        }
+    }
+    log(LogLevel::DEBUG, "Solver solved " + to_string(targetCount - remaining) + " of " + to_string(targetCount) + " targets after " + to_string(nodes) + " nodes");
+    return solutions;
+}
+
+/**
+ * @brief The buildSolution function walks back from a goal state to the start state to rebuild the moves of a solution
+ *
+ * @param parents The search tree
+ * @param start The start state
+ * @param goal The goal state, it has to be in the search tree
+ * @param nodes The number of nodes explored to reach the goal
+ * @return Solution
+ */
+Solution Solver::buildSolution(const ParentMap& parents, State start, State goal, long long nodes){
+    Solution solution;
+    solution.solved = true;
+    solution.nodes = nodes;
+    for(State state = goal; state != start; state = parents.at(state).first){
+        unsigned char move = parents.at(state).second;
+        solution.moves.push_back({move / 4, directionToChar(move % 4)});
+    }
+    reverse(solution.moves.begin(), solution.moves.end());
+    return solution;
+}
@@ -0,0 +1,70 @@
+/**
+ * @file solver.h
+ * @author Bastien
+ * @brief Class for the solver
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+#ifndef SOLVER_H
+#define SOLVER_H
+
+#include "board.h"
+#include "robot.h"
+#include "snapshot.h"
+#include "symmetry.h"
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief A single move of a solution: the robot number and the direction ('N', 'E', 'S' or 'W') it was moved in.
+ */
+struct Move{
+    int robot;
+    char direction;
+};
+
+/**
+ * @brief The result of a search: whether a solution was found, the moves of the solution and the number of nodes explored.
+ */
+struct Solution{
+    bool solved;
+    vector<Move> moves;
+    long long nodes;
+};
+
+/**
+ * Type definition for the search tree: for each visited state, the previous state and the move that led to it (robot * 4 + direction).
+ */
+typedef unordered_map<State, pair<State, unsigned char>> ParentMap;
+
+/**
+ * @brief The Solver class computes the optimal solution of a round.
+ * @details The solver works on a snapshot of the board and on packed states only, so the tiles and robots of the game are never modified and the board may change while a search runs.
+ * It runs a breadth-first search from the current robot placement until the robot matching the objective tile (or any robot for the multicolored target) stands on the objective tile.
+ * solveAll runs the same search once for every target of the board: the robots start from the same cells in every round, so one traversal gives the answers of a whole session.
+ */
+class Solver{
+    private:
+        shared_ptr<const BoardSnapshot> board;
+        static Solution buildSolution(const ParentMap& parents, State start, State goal, long long nodes);
+
+    public:
+        Solver(Board* b);
+        Solver(shared_ptr<const BoardSnapshot> b);
+        static State packState(const int cells[ROBOT_COUNT]);
+        static int getRobotCell(State state, int robot);
+        static State setRobotCell(State state, int robot, int cell);
+        static char directionToChar(int direction);
+        int slide(State state, int robot, int direction);
+        Solution solve(Robot* robots[ROBOT_COUNT], Tile* objectiveTile);
+        Solution solve(State start, int targetCell, int targetRobot);
+        vector<Solution> solveAll(Robot* robots[ROBOT_COUNT]);
+        vector<Solution> solveAll(State start, const char colors[ROBOT_COUNT]);
+};
+
+#endif // SOLVER_H
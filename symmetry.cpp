@@ -0,0 +1,114 @@
+/**
+ * @file symmetry.cpp
+ * @author Bastien
+ * @brief Class for the symmetries between robots (Implementation File)
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+#include "symmetry.h"
+#include "solver.h"
+
+/**
+ * @brief Construct a new Symmetry:: Symmetry object where no robots can be swapped
+ *
+ */
+Symmetry::Symmetry(){
+}
+
+/**
+ * @brief Construct a new Symmetry:: Symmetry object for a round
+ *
+ * @param board
+ * @param targetRobot The robot that has to reach the target, or -1 if any robot can
+ */
+Symmetry::Symmetry(const BoardSnapshot& board, int targetRobot){
+    bool used[ROBOT_COUNT] = {false};
+    for(int i = 0; i < ROBOT_COUNT; i++){
+        if(used[i] || i == targetRobot){
+            continue;
+        }
+        vector<int> robots(1, i);
+        for(int j = i + 1; j < ROBOT_COUNT; j++){
+            if(j != targetRobot && board.getPathGroup(j) == board.getPathGroup(i)){
+                robots.push_back(j);
+                used[j] = true;
+            }
+        }
+        if(robots.size() > 1){
+            this->classes.push_back(robots);
+        }
+    }
+}
+
+/**
+ * @brief The isTrivial function checks if no robots can be swapped
+ *
+ * @return true if canonical returns every state unchanged
+ * @return false
+ */
+bool Symmetry::isTrivial() const{
+    return this->classes.empty();
+}
+
+/**
+ * @brief The getClasses function returns the sets of swappable robots
+ *
+ * @return The sets of at least 2 robots, each in increasing order
+ */
+const vector<vector<int>>& Symmetry::getClasses() const{
+    return this->classes;
+}
+
+/**
+ * @brief The canonical function returns the canonical form of a state: the cells of each set of swappable robots sorted, the smallest cell going to the robot with the smallest number
+ *
+ * @param state
+ * @return State
+ */
+State Symmetry::canonical(State state) const{
+    RobotState robots(state);
+    for(const vector<int>& robotClass : this->classes){
+        int cells[ROBOT_COUNT];
+        int count = robotClass.size();
+        for(int i = 0; i < count; i++){
+            int cell = robots.cellOf(robotClass[i]);
+            int j = i;
+            for(; j > 0 && cells[j - 1] > cell; j--){
+                cells[j] = cells[j - 1];
+            }
+            cells[j] = cell;
+        }
+        for(int i = 0; i < count; i++){
+            robots.move(robotClass[i], cells[i]);
+        }
+    }
+    return robots.getState();
+}
+
+/**
+ * @brief The mapMoves function turns moves found on canonical states into moves of the real robots
+ * @details The moves are played again from the real start state: each move names the robot at some place of the canonical state, which is found back in the real state by its cell.
+ *
+ * @param board
+ * @param start The real start state
+ * @param moves The moves found from canonical(start)
+ * @return The same moves, made by the real robots
+ */
+vector<Move> Symmetry::mapMoves(const BoardSnapshot& board, State start, const vector<Move>& moves) const{
+    const string directions = "NESW";
+    vector<Move> real;
+    RobotState robots(start);
+    State current = this->canonical(start);
+    for(const Move& move : moves){
+        int robot = robots.robotAt(Solver::getRobotCell(current, move.robot));
+        int direction = directions.find(move.direction);
+        robots.move(robot, board.slide(robots, robot, direction));
+        current = this->canonical(robots.getState());
+        real.push_back({robot, move.direction});
+    }
+    return real;
+}
@@ -0,0 +1,40 @@
+/**
+ * @file symmetry.h
+ * @author Bastien
+ * @brief Class for the symmetries between robots
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+#ifndef SYMMETRY_H
+#define SYMMETRY_H
+
+#include "snapshot.h"
+#include <vector>
+
+struct Move;
+
+/**
+ * @brief The Symmetry class finds the robots that can be swapped without changing a round, and puts states in a canonical form.
+ * @details Two robots can be swapped when they follow the same paths (always, without deflectors) and neither of them has to reach the target. Swapping them gives a state with the same solutions, so the searches only keep one state of each set of swapped states: the canonical one, where the cells of the swappable robots are sorted.
+ * For a colored target the other robots are all swappable, for the multicolored target every robot is.
+ * The moves found on canonical states name the robots by their place in the canonical state, mapMoves turns them back into moves of the real robots.
+ */
+class Symmetry{
+    private:
+        // The sets of at least 2 swappable robots, each in increasing order
+        vector<vector<int>> classes;
+
+    public:
+        Symmetry();
+        Symmetry(const BoardSnapshot& board, int targetRobot);
+        bool isTrivial() const;
+        const vector<vector<int>>& getClasses() const;
+        State canonical(State state) const;
+        vector<Move> mapMoves(const BoardSnapshot& board, State start, const vector<Move>& moves) const;
+};
+
+#endif // SYMMETRY_H
@@ -0,0 +1,525 @@
+/**
+ * @file tablebase.cpp
+ * @author Bastien
+ * @brief Class for the complete distance tables of a target (Implementation File)
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+#include "tablebase.h"
+#include "log.h"
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/**
+ * The first bytes of a tablebase file, followed by the version of the format.
+ */
+const char TABLEBASE_MAGIC[4] = {'R', 'R', 'T', 'B'};
+const uint32_t TABLEBASE_VERSION = 1;
+
+/**
+ * @brief The header of a tablebase file, followed by the packed distances.
+ */
+struct TablebaseHeader{
+    char magic[4];
+    uint32_t version;
+    uint32_t cells;
+    uint32_t robots;
+    int32_t targetCell;
+    int32_t targetRobot;
+    int32_t maxDepth;
+    // The path group of each robot, 4 bits each
+    uint32_t groups;
+    uint64_t hash;
+    uint64_t entryCount;
+};
+
+/**
+ * @brief The binomial function returns the number of sets of k cells of the board
+ *
+ * @param n The number of cells
+ * @param k The size of the sets, at most ROBOT_COUNT
+ * @return uint64_t
+ */
+static uint64_t binomial(int n, int k){
+    static const vector<uint64_t> table = [](){
+        vector<uint64_t> values((CELL_COUNT + 1) * (ROBOT_COUNT + 1), 0);
+        for(int i = 0; i <= CELL_COUNT; i++){
+            values[i * (ROBOT_COUNT + 1)] = 1;
+            for(int j = 1; j <= ROBOT_COUNT && j <= i; j++){
+                values[i * (ROBOT_COUNT + 1) + j] = values[(i - 1) * (ROBOT_COUNT + 1) + j - 1] + values[(i - 1) * (ROBOT_COUNT + 1) + j];
+            }
+        }
+        return values;
+    }();
+    return table[n * (ROBOT_COUNT + 1) + k];
+}
+
+/**
+ * @brief Returns the path group of every robot packed in one integer, 4 bits each
+ *
+ * @param board
+ * @return uint32_t
+ */
+static uint32_t packGroups(const BoardSnapshot& board){
+    uint32_t groups = 0;
+    for(int i = 0; i < ROBOT_COUNT; i++){
+        groups |= board.getPathGroup(i) << (4 * i);
+    }
+    return groups;
+}
+
+/**
+ * @brief Construct a new Tablebase:: Tablebase object
+ * @details The table is empty until build or open is called.
+ *
+ * @param b The snapshot of the board
+ * @param targetCell The cell to reach
+ * @param targetRobot The robot that has to reach the cell, or -1 if any robot can reach it
+ */
+Tablebase::Tablebase(shared_ptr<const BoardSnapshot> b, int targetCell, int targetRobot) : symmetry(*b, targetRobot){
+    this->board = b;
+    this->targetCell = targetCell;
+    this->targetRobot = targetRobot;
+    this->maxDepth = 0;
+    this->distances = nullptr;
+    this->mapping = nullptr;
+    this->mappingSize = 0;
+
+    vector<bool> swappable(ROBOT_COUNT, false);
+    for(const vector<int>& robotClass : this->symmetry.getClasses()){
+        for(int robot : robotClass){
+            swappable[robot] = true;
+        }
+    }
+    // The count is only needed up to the largest table, so it stops growing past it
+    this->entryCount = 1;
+    for(int i = 0; i < ROBOT_COUNT; i++){
+        if(!swappable[i]){
+            this->fixedRobots.push_back(i);
+            this->entryCount = min(this->entryCount * CELL_COUNT, TABLEBASE_MAX_ENTRIES + 1);
+        }
+    }
+    for(const vector<int>& robotClass : this->symmetry.getClasses()){
+        uint64_t count = binomial(CELL_COUNT, robotClass.size());
+        this->entryCount = count > TABLEBASE_MAX_ENTRIES ? TABLEBASE_MAX_ENTRIES + 1 : min(this->entryCount * count, TABLEBASE_MAX_ENTRIES + 1);
+    }
+}
+
+/**
+ * @brief Destroy the Tablebase:: Tablebase object, unmapping its file
+ *
+ */
+Tablebase::~Tablebase(){
+    this->unmap();
+}
+
+/**
+ * @brief The unmap function releases the mapped file, if any
+ *
+ */
+void Tablebase::unmap(){
+    if(this->mapping != nullptr){
+        munmap(this->mapping, this->mappingSize);
+        this->mapping = nullptr;
+        this->mappingSize = 0;
+        this->distances = nullptr;
+    }
+}
+
+/**
+ * @brief The getEntryCount function returns the number of positions of the table
+ *
+ * @return The number of canonical placements, or more than TABLEBASE_MAX_ENTRIES if the table is too large to be built
+ */
+uint64_t Tablebase::getEntryCount() const{
+    return this->entryCount;
+}
+
+/**
+ * @brief The getMaxDepth function returns the largest distance held by the table
+ *
+ * @return int
+ */
+int Tablebase::getMaxDepth() const{
+    return this->maxDepth;
+}
+
+/**
+ * @brief The isReady function checks if the table was built or opened
+ *
+ * @return true
+ * @return false
+ */
+bool Tablebase::isReady() const{
+    return this->distances != nullptr;
+}
+
+/**
+ * @brief The getPath function returns the path of the file of the table, named after the hash of the board, the target and the paths of the target robot
+ *
+ * @param directory
+ * @return string
+ */
+string Tablebase::getPath(const string& directory) const{
+    char name[64];
+    snprintf(name, sizeof(name), "%016llx-%d-%s.rtb", (unsigned long long)this->board->getHash(), this->targetCell, this->targetRobot == -1 ? "m" : to_string(this->board->getPathGroup(this->targetRobot)).c_str());
+    return directory + "/" + name;
+}
+
+/**
+ * @brief The rank function returns the index of a canonical state in the table
+ *
+ * @param canonical A valid state in canonical form
+ * @return uint64_t
+ */
+uint64_t Tablebase::rank(State canonical) const{
+    uint64_t index = 0;
+    for(int robot : this->fixedRobots){
+        index = index * CELL_COUNT + Solver::getRobotCell(canonical, robot);
+    }
+    for(const vector<int>& robotClass : this->symmetry.getClasses()){
+        // The cells of the class are sorted, the set is ranked in the combinatorial number system
+        uint64_t digit = 0;
+        for(int i = 0; i < robotClass.size(); i++){
+            digit += binomial(Solver::getRobotCell(canonical, robotClass[i]), i + 1);
+        }
+        index = index * binomial(CELL_COUNT, robotClass.size()) + digit;
+    }
+    return index;
+}
+
+/**
+ * @brief The unrank function returns the canonical state of an index of the table
+ * @details The robots that cannot be swapped may share a cell with another robot, see isValid.
+ *
+ * @param index
+ * @return State
+ */
+State Tablebase::unrank(uint64_t index) const{
+    RobotState robots;
+    const vector<vector<int>>& classes = this->symmetry.getClasses();
+    for(int c = classes.size() - 1; c >= 0; c--){
+        int count = classes[c].size();
+        uint64_t size = binomial(CELL_COUNT, count);
+        uint64_t digit = index % size;
+        index /= size;
+        for(int i = count - 1; i >= 0; i--){
+            // The largest cell whose binomial fits in what is left of the digit
+            int low = i;
+            int high = CELL_COUNT - 1;
+            while(low < high){
+                int middle = (low + high + 1) / 2;
+                if(binomial(middle, i + 1) <= digit){
+                    low = middle;
+                }else{
+                    high = middle - 1;
+                }
+            }
+            digit -= binomial(low, i + 1);
+            robots.move(classes[c][i], low);
+        }
+    }
+    for(int i = this->fixedRobots.size() - 1; i >= 0; i--){
+        robots.move(this->fixedRobots[i], index % CELL_COUNT);
+        index /= CELL_COUNT;
+    }
+    return robots.getState();
+}
+
+/**
+ * @brief The get function returns the value stored for an index
+ *
+ * @param index
+ * @return The distance, or TABLEBASE_UNKNOWN
+ */
+int Tablebase::get(uint64_t index) const{
+    return (this->distances[index / 2] >> ((index % 2) * 4)) & 15;
+}
+
+/**
+ * @brief The set function stores the distance of an index, the table being built in memory
+ *
+ * @param index
+ * @param distance
+ */
+void Tablebase::set(uint64_t index, int distance){
+    unsigned char& byte = this->table[index / 2];
+    int shift = (index % 2) * 4;
+    byte = (byte & ~(15 << shift)) | (distance << shift);
+}
+
+/**
+ * @brief The isValid function checks that no two robots of a state share a cell
+ *
+ * @param state
+ * @return true
+ * @return false
+ */
+bool Tablebase::isValid(State state) const{
+    for(int i = 0; i < ROBOT_COUNT; i++){
+        for(int j = i + 1; j < ROBOT_COUNT; j++){
+            if(Solver::getRobotCell(state, i) == Solver::getRobotCell(state, j)){
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief The isGoal function checks if a state solves the target
+ *
+ * @param state
+ * @return true
+ * @return false
+ */
+bool Tablebase::isGoal(State state) const{
+    for(int i = 0; i < ROBOT_COUNT; i++){
+        if((this->targetRobot == -1 || this->targetRobot == i) && Solver::getRobotCell(state, i) == this->targetCell){
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief The build function computes the distance of every position by a retrograde breadth-first search
+ *
+ * @param depth The largest distance to compute, at most TABLEBASE_MAX_DISTANCE
+ * @return false if the table is too large
+ */
+bool Tablebase::build(int depth){
+    if(this->entryCount > TABLEBASE_MAX_ENTRIES){
+        log(LogLevel::ERROR, "The tablebase of this board is too large to be built");
+        return false;
+    }
+    this->unmap();
+    this->maxDepth = max(0, min(depth, TABLEBASE_MAX_DISTANCE));
+    this->table.assign((this->entryCount + 1) / 2, 0xFF);
+    this->distances = this->table.data();
+
+    uint64_t count = 0;
+    for(uint64_t index = 0; index < this->entryCount; index++){
+        State state = this->unrank(index);
+        if(this->isValid(state) && this->isGoal(state)){
+            this->set(index, 0);
+            count++;
+        }
+    }
+    log(LogLevel::DEBUG, "Tablebase level 0: " + to_string(count) + " positions");
+
+    vector<int> cells;
+    State successors[MOVE_COUNT];
+    for(int distance = 0; distance < this->maxDepth && count > 0; distance++){
+        count = 0;
+        if(!this->board->hasDeflectors()){
+            // The positions one reverse move away from the last level
+            for(uint64_t index = 0; index < this->entryCount; index++){
+                if(this->get(index) != distance){
+                    continue;
+                }
+                RobotState robots(this->unrank(index));
+                for(int robot = 0; robot < ROBOT_COUNT; robot++){
+                    for(int direction = 0; direction < 4; direction++){
+                        this->board->unslide(robots, robot, direction, cells);
+                        for(int from : cells){
+                            RobotState previous = robots;
+                            previous.move(robot, from);
+                            uint64_t next = this->rank(this->symmetry.canonical(previous.getState()));
+                            if(this->get(next) == TABLEBASE_UNKNOWN){
+                                this->set(next, distance + 1);
+                                count++;
+                            }
+                        }
+                    }
+                }
+            }
+        }else{
+            // The unknown positions one move away from the last level
+            for(uint64_t index = 0; index < this->entryCount; index++){
+                if(this->get(index) != TABLEBASE_UNKNOWN){
+                    continue;
+                }
+                State state = this->unrank(index);
+                if(!this->isValid(state)){
+                    continue;
+                }
+                this->board->expand(&state, 1, successors);
+                for(int move = 0; move < MOVE_COUNT; move++){
+                    if(successors[move] != state && this->get(this->rank(this->symmetry.canonical(successors[move]))) == distance){
+                        this->set(index, distance + 1);
+                        count++;
+                        break;
+                    }
+                }
+            }
+        }
+        log(LogLevel::DEBUG, "Tablebase level " + to_string(distance + 1) + ": " + to_string(count) + " positions");
+    }
+    return true;
+}
+
+/**
+ * @brief The save function writes the table to a file
+ * @details The file is written next to its final name and renamed, so a run that stops midway never leaves a partial table behind.
+ *
+ * @param path
+ * @return true if the file was written
+ */
+bool Tablebase::save(const string& path) const{
+    if(!this->isReady()){
+        return false;
+    }
+    TablebaseHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, TABLEBASE_MAGIC, 4);
+    header.version = TABLEBASE_VERSION;
+    header.cells = CELL_COUNT;
+    header.robots = ROBOT_COUNT;
+    header.targetCell = this->targetCell;
+    header.targetRobot = this->targetRobot;
+    header.maxDepth = this->maxDepth;
+    header.groups = packGroups(*this->board);
+    header.hash = this->board->getHash();
+    header.entryCount = this->entryCount;
+    string temporary = path + ".tmp";
+    {
+        ofstream file(temporary, ios::binary | ios::trunc);
+        if(!file.write((const char*)&header, sizeof(header)) || !file.write((const char*)this->distances, (this->entryCount + 1) / 2)){
+            log(LogLevel::WARNING, "Could not write tablebase " + path);
+            return false;
+        }
+    }
+    if(rename(temporary.c_str(), path.c_str()) != 0){
+        log(LogLevel::WARNING, "Could not write tablebase " + path);
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief The open function maps a tablebase file read-only in memory
+ * @details The pages are shared with every other process mapping the same file and only read from disk when they are used.
+ *
+ * @param path
+ * @return true if the file holds the table of this board and target
+ * @return false
+ */
+bool Tablebase::open(const string& path){
+    int file = ::open(path.c_str(), O_RDONLY);
+    if(file == -1){
+        return false;
+    }
+    struct stat status;
+    size_t size = sizeof(TablebaseHeader) + (this->entryCount + 1) / 2;
+    if(fstat(file, &status) != 0 || (size_t)status.st_size != size){
+        ::close(file);
+        log(LogLevel::WARNING, "Tablebase " + path + " does not match the board");
+        return false;
+    }
+    void* mapping = mmap(nullptr, size, PROT_READ, MAP_SHARED, file, 0);
+    ::close(file);
+    if(mapping == MAP_FAILED){
+        log(LogLevel::WARNING, "Could not map tablebase " + path);
+        return false;
+    }
+    const TablebaseHeader* header = (const TablebaseHeader*)mapping;
+    if(memcmp(header->magic, TABLEBASE_MAGIC, 4) != 0 || header->version != TABLEBASE_VERSION || header->cells != CELL_COUNT || header->robots != ROBOT_COUNT || header->targetCell != this->targetCell || header->targetRobot != this->targetRobot || header->groups != packGroups(*this->board) || header->hash != this->board->getHash() || header->entryCount != this->entryCount){
+        munmap(mapping, size);
+        log(LogLevel::WARNING, "Tablebase " + path + " does not match the board");
+        return false;
+    }
+    this->unmap();
+    vector<unsigned char>().swap(this->table);
+    this->mapping = mapping;
+    this->mappingSize = size;
+    this->maxDepth = header->maxDepth;
+    this->distances = (const unsigned char*)mapping + sizeof(TablebaseHeader);
+    return true;
+}
+
+/**
+ * @brief The getDistance function returns the number of moves needed to reach the target from a placement
+ *
+ * @param state The cells of the robots, in any order of the swappable robots
+ * @return The number of moves of an optimal solution, or -1 if it needs more than getMaxDepth moves or the target cannot be reached
+ */
+int Tablebase::getDistance(State state) const{
+    if(!this->isReady() || !this->isValid(state)){
+        return -1;
+    }
+    int distance = this->get(this->rank(this->symmetry.canonical(state)));
+    return distance == TABLEBASE_UNKNOWN ? -1 : distance;
+}
+
+/**
+ * @brief The solve function gives an optimal solution from a placement by following the distances down to 0
+ * @details Each step looks for a move leading to a placement one move closer to the target, so it costs MOVE_COUNT reads of the table.
+ *
+ * @param start The start state
+ * @return Solution, not solved if the distance is unknown
+ */
+Solution Tablebase::solve(State start) const{
+    Solution solution;
+    solution.solved = false;
+    solution.nodes = 0;
+    int distance = this->getDistance(start);
+    if(distance < 0){
+        return solution;
+    }
+    State state = start;
+    State successors[MOVE_COUNT];
+    for(; distance > 0; distance--){
+        this->board->expand(&state, 1, successors);
+        solution.nodes++;
+        int move = 0;
+        while(move < MOVE_COUNT && (successors[move] == state || this->getDistance(successors[move]) != distance - 1)){
+            move++;
+        }
+        if(move == MOVE_COUNT){
+            log(LogLevel::ERROR, "Tablebase has no move down from distance " + to_string(distance));
+            return solution;
+        }
+        solution.moves.push_back({move / 4, Solver::directionToChar(move % 4)});
+        state = successors[move];
+    }
+    solution.solved = true;
+    return solution;
+}
+
+/**
+ * @brief The get function gives the tablebase of a target, mapping its file or building and saving it the first time
+ *
+ * @param b The snapshot of the board
+ * @param targetCell The cell to reach
+ * @param targetRobot The robot that has to reach the cell, or -1 if any robot can reach it
+ * @param directory The directory of the tablebase files
+ * @return The tablebase, or nullptr if it is too large to be built
+ */
+shared_ptr<const Tablebase> Tablebase::get(shared_ptr<const BoardSnapshot> b, int targetCell, int targetRobot, const string& directory){
+    shared_ptr<Tablebase> tablebase = make_shared<Tablebase>(b, targetCell, targetRobot);
+    string path = tablebase->getPath(directory);
+    if(tablebase->open(path)){
+        return tablebase;
+    }
+    if(!tablebase->build()){
+        return nullptr;
+    }
+    error_code error;
+    filesystem::create_directories(directory, error);
+    // Once saved, the table is used from the file so that its pages are shared
+    if(tablebase->save(path)){
+        tablebase->open(path);
+    }
+    return tablebase;
+}
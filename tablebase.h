@@ -0,0 +1,87 @@
+/**
+ * @file tablebase.h
+ * @author Bastien
+ * @brief Class for the complete distance tables of a target
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+#ifndef TABLEBASE_H
+#define TABLEBASE_H
+
+#include "solver.h"
+#include "symmetry.h"
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * The directory the tablebases are saved in.
+ */
+const char TABLEBASE_DIRECTORY[] = "tablebases";
+
+/**
+ * The largest distance a tablebase can hold, the distances being stored on 4 bits.
+ */
+const int TABLEBASE_MAX_DISTANCE = 14;
+
+/**
+ * The value stored for a position that needs more moves than the depth of the tablebase, or that cannot be solved.
+ */
+const int TABLEBASE_UNKNOWN = 15;
+
+/**
+ * The largest number of positions of a tablebase (2 GB of distances).
+ */
+const uint64_t TABLEBASE_MAX_ENTRIES = (uint64_t)1 << 32;
+
+/**
+ * @brief The Tablebase class holds the number of moves needed to reach one target from every placement of the robots.
+ * @details Only the canonical placements are stored (see Symmetry): the robots that cannot be swapped give one digit each (their cell), and each set of swappable robots gives one digit, the rank of its sorted cells among all the sets of that many cells. On the classic board this is 256 x C(256, 3) positions for a colored target instead of 2^32, and C(256, 4) for the multicolored one.
+ * The table is built by a retrograde breadth-first search: the positions solving the target have distance 0, and the positions at distance d + 1 are found from those at distance d with the reverse moves (BoardSnapshot::unslide). Reverse moves do not follow deflectors, so on a board with deflectors every unknown position is instead expanded forward at each level. The search stops at a depth of at most TABLEBASE_MAX_DISTANCE, deeper positions being left unknown.
+ * The distances are packed 2 per byte in a file that later runs map read-only in memory, so the answer for a placement is a single read and several processes share the same pages.
+ */
+class Tablebase{
+    private:
+        shared_ptr<const BoardSnapshot> board;
+        int targetCell;
+        int targetRobot;
+        int maxDepth;
+        Symmetry symmetry;
+        // The robots that cannot be swapped, each one a digit of the index
+        vector<int> fixedRobots;
+        uint64_t entryCount;
+        vector<unsigned char> table;
+        const unsigned char* distances;
+        void* mapping;
+        size_t mappingSize;
+
+        uint64_t rank(State canonical) const;
+        State unrank(uint64_t index) const;
+        int get(uint64_t index) const;
+        void set(uint64_t index, int distance);
+        bool isValid(State state) const;
+        bool isGoal(State state) const;
+        void unmap();
+
+    public:
+        Tablebase(shared_ptr<const BoardSnapshot> b, int targetCell, int targetRobot);
+        ~Tablebase();
+        Tablebase(const Tablebase&) = delete;
+        Tablebase& operator=(const Tablebase&) = delete;
+        uint64_t getEntryCount() const;
+        int getMaxDepth() const;
+        string getPath(const string& directory) const;
+        bool build(int depth = TABLEBASE_MAX_DISTANCE);
+        bool save(const string& path) const;
+        bool open(const string& path);
+        bool isReady() const;
+        int getDistance(State state) const;
+        Solution solve(State start) const;
+        static shared_ptr<const Tablebase> get(shared_ptr<const BoardSnapshot> b, int targetCell, int targetRobot, const string& directory = TABLEBASE_DIRECTORY);
+};
+
+#endif // TABLEBASE_H
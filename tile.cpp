@@ -11,23 +11,42 @@
 
 #include "tile.h"
 
+// Characters of the color and symbol codes stored in a tile, code 0 being "none"
+const char COLOR_CODES[] = " RGBYMS";
+const char SYMBOL_CODES[] = " &#%$*";
+const char DEFLECTOR_CODES[] = " /\\";
+
+static_assert(sizeof(Tile) == 2, "a tile is packed in 2 bytes");
+
+/**
+ * @brief Finds the code of a character in a code table
+ * 
+ * @param codes The code table
+ * @param c The character
+ * @return The code of the character, or 0 if it is not in the table
+ */
+static unsigned char encode(const char* codes, char c){
+    for(unsigned char i = 1; codes[i] != '\0'; i++){
+        if(codes[i] == c){
+            return i;
+        }
+    }
+    return 0;
+}
+
 /**
  * @brief Construct a new Tile:: Tile object
  * 
  */
 Tile::Tile(){
-    this->topWall = false;
-    this->bottomWall = false;
-    this->leftWall = false;
-    this->rightWall = false;
+    this->walls = 0;
     this->hasTarget = false;
     this->hasCorner = false;
     this->hasSpecialTarget = false;
-    this->hasRobot = false;
     this->isCentralTile = false;
-    this->targetColor = ' ';
-    this->targetSymbol = ' ';
-    this->robotColor = ' ';
+    this->targetColor = 0;
+    this->targetSymbol = 0;
+    this->deflector = 0;
 }
 
 /**
@@ -40,29 +59,23 @@ Tile::Tile(){
  * @param hasT Has target
  * @param hasC Has corner
  * @param hasST Has special target
- * @param hasR Has robot
  * @param isCentral Is central tile
  * @param tColor Target color
  * @param tSymbol Target symbol
- * @param rColor Robot color
- * @param x X position
- * @param y Y position
  */
-Tile::Tile(bool t, bool b, bool l, bool r, bool hasT, bool hasC, bool hasST, bool hasR, bool isCentral, char tColor, char tSymbol, char rColor, int x, int y){
-    this->topWall = t;
-    this->bottomWall = b;
-    this->leftWall = l;
-    this->rightWall = r;
+Tile::Tile(bool t, bool b, bool l, bool r, bool hasT, bool hasC, bool hasST, bool isCentral, char tColor, char tSymbol){
+    this->walls = 0;
+    this->setTopWall(t);
+    this->setBottomWall(b);
+    this->setLeftWall(l);
+    this->setRightWall(r);
     this->hasTarget = hasT;
     this->hasCorner = hasC;
     this->hasSpecialTarget = hasST;
-    this->hasRobot = hasR;
     this->isCentralTile = isCentral;
-    this->targetColor = tColor;
-    this->targetSymbol = tSymbol;
-    this->robotColor = rColor;
-    this->positionX = x;
-    this->positionY = y;
+    this->setTargetColor(tColor);
+    this->setTargetSymbol(tSymbol);
+    this->deflector = 0;
 }
 
 /**
@@ -72,7 +85,7 @@ Tile::Tile(bool t, bool b, bool l, bool r, bool hasT, bool hasC, bool hasST, boo
  * @return false 
  */
 bool Tile::checkHasWall(){
-    return (this->topWall || this->bottomWall || this->leftWall || this->rightWall);
+    return this->walls != 0;
 }
 
 /**
@@ -82,7 +95,7 @@ bool Tile::checkHasWall(){
  * @return false 
  */
 bool Tile::checkHasTopWall(){
-    return this->topWall;
+    return this->walls & 1;
 }
 
 /**
@@ -92,7 +105,7 @@ bool Tile::checkHasTopWall(){
  * @return false 
  */
 bool Tile::checkHasBottomWall(){
-    return this->bottomWall;
+    return this->walls & 4;
 }
 
 /**
@@ -102,7 +115,7 @@ bool Tile::checkHasBottomWall(){
  * @return false 
  */
 bool Tile::checkHasLeftWall(){
-    return this->leftWall;
+    return this->walls & 8;
 }
 
 /**
@@ -112,7 +125,7 @@ bool Tile::checkHasLeftWall(){
  * @return false 
  */
 bool Tile::checkHasRightWall(){
-    return this->rightWall;
+    return this->walls & 2;
 }
 
 /**
@@ -145,16 +158,6 @@ bool Tile::checkHasSpecialTarget(){
     return this->hasSpecialTarget;
 }
 
-/**
- * @brief The checkHasRobot function checks if the tile has a robot
- * 
- * @return true 
- * @return false 
- */
-bool Tile::checkHasRobot(){
-    return this->hasRobot;
-}
-
 /**
  * @brief The checkIsCentralTile function checks if the tile one of the central tiles
  * 
@@ -171,7 +174,7 @@ bool Tile::checkIsCentralTile(){
  * @return char 
  */
 char Tile::getTargetColor(){
-    return this->targetColor;
+    return COLOR_CODES[this->targetColor];
 }
 
 /**
@@ -180,16 +183,7 @@ char Tile::getTargetColor(){
  * @return char 
  */
 char Tile::getTargetSymbol(){
-    return this->targetSymbol;
-}
-
-/**
- * @brief The getRobotColor function returns the robot color
- * 
- * @return char 
- */
-char Tile::getRobotColor(){
-    return this->robotColor;
+    return SYMBOL_CODES[this->targetSymbol];
 }
 
 /**
@@ -198,7 +192,7 @@ char Tile::getRobotColor(){
  * @param t 
  */
 void Tile::setTopWall(bool t){
-    this->topWall = t;
+    this->walls = t ? (this->walls | 1) : (this->walls & ~1);
 }
 
 /**
@@ -207,7 +201,7 @@ void Tile::setTopWall(bool t){
  * @param b 
  */
 void Tile::setBottomWall(bool b){
-    this->bottomWall = b;
+    this->walls = b ? (this->walls | 4) : (this->walls & ~4);
 }
 
 /**
@@ -216,7 +210,7 @@ void Tile::setBottomWall(bool b){
  * @param l 
  */
 void Tile::setLeftWall(bool l){
-    this->leftWall = l;
+    this->walls = l ? (this->walls | 8) : (this->walls & ~8);
 }
 
 /**
@@ -225,7 +219,7 @@ void Tile::setLeftWall(bool l){
  * @param r 
  */
 void Tile::setRightWall(bool r){
-    this->rightWall = r;
+    this->walls = r ? (this->walls | 2) : (this->walls & ~2);
 }
 
 /**
@@ -255,15 +249,6 @@ void Tile::setHasSpecialTarget(bool sc){
     this->hasSpecialTarget = sc;
 }
 
-/**
- * @brief The setHasRobot function sets that the tile has a robot
- * 
- * @param r 
- */
-void Tile::setHasRobot(bool r){
-    this->hasRobot = r;
-}
-
 /**
  * @brief The setIsCentralTile function sets that the tile is one of the central tiles
  * 
@@ -279,7 +264,7 @@ void Tile::setIsCentralTile(bool c){
  * @param c 
  */
 void Tile::setTargetColor(char c){
-    this->targetColor = c;
+    this->targetColor = encode(COLOR_CODES, c);
 }
 
 /**
@@ -288,51 +273,58 @@ void Tile::setTargetColor(char c){
  * @param s 
  */
 void Tile::setTargetSymbol(char s){
-    this->targetSymbol = s;
+    this->targetSymbol = encode(SYMBOL_CODES, s);
 }
 
 /**
- * @brief The setRobotColor function sets the robot color
+ * @brief The getWalls function returns the walls of the tile as a bit mask (1 = top, 2 = right, 4 = bottom, 8 = left)
  * 
- * @param c 
+ * @return unsigned char 
  */
-void Tile::setRobotColor(char c){
-    this->robotColor = c;
+unsigned char Tile::getWalls(){
+    return this->walls;
 }
 
 /**
- * @brief The getX function returns the x position of the tile
+ * @brief The setWall function sets or removes the wall on one side of the tile
  * 
- * @return int 
+ * @param direction 0 = N (top), 1 = E (right), 2 = S (bottom), 3 = W (left)
+ * @param w 
  */
-int Tile::getX(){
-    return this->positionX;
+void Tile::setWall(int direction, bool w){
+    this->walls = w ? (this->walls | (1 << direction)) : (this->walls & ~(1 << direction));
 }
 
 /**
- * @brief The getY function returns the y position of the tile
+ * @brief The getDeflector function returns the diagonal deflector of the tile
  * 
- * @return int 
+ * @return '/', '\\' or ' ' if the tile has no deflector
  */
-int Tile::getY(){
-    return this->positionY;
+char Tile::getDeflector(){
+    return DEFLECTOR_CODES[this->deflector];
 }
 
 /**
- * @brief The setX function sets the x position of the tile
+ * @brief The getDeflectorColor function returns the color of the diagonal deflector of the tile
+ * @details Robots of this color go through the deflector, the other robots are turned by 90 degrees.
  * 
- * @param x 
+ * @return char 
  */
-void Tile::setX(int x){
-    this->positionX = x;
+char Tile::getDeflectorColor(){
+    return this->deflector ? COLOR_CODES[this->targetColor] : ' ';
 }
 
 /**
- * @brief The setY function sets the y position of the tile
+ * @brief The setDeflector function puts a diagonal deflector on the tile, or removes it
+ * @details The tile loses its target, if any.
  * 
- * @param y 
+ * @param d '/', '\\' or ' ' to remove the deflector
+ * @param color The color of the deflector
  */
-void Tile::setY(int y){
-    this->positionY = y;
+void Tile::setDeflector(char d, char color){
+    this->deflector = encode(DEFLECTOR_CODES, d);
+    this->hasTarget = false;
+    this->hasSpecialTarget = false;
+    this->targetSymbol = 0;
+    this->targetColor = this->deflector ? encode(COLOR_CODES, color) : 0;
 }
-
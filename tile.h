@@ -17,25 +17,26 @@ using namespace std;
 
 /**
  * @brief The Tile class represents a single tile on the game board. 
- * @details Since the game board is a 16x16 grid, there are 256 tiles in total. Each tile can have walls on one or more of its sides, a target and/or a robot.
+ * @details The game board has one tile per cell, 16x16 = 256 tiles on the classic board (see BOARD_SIZE). Each tile can have walls on one or more of its sides and a target. The robots are tracked by the board.
+ * The tile is packed in 2 bytes (walls and flags as bit fields, colors and symbols as small codes) so that the whole board is stored in one contiguous array that stays in cache. A tile does not store its position: it is implied by the index of the tile in the board (see Board::getCell).
+ * In the diagonal variant a tile can hold a colored deflector ('/' or '\\') instead of a target. A deflector tile never has a target, so the color of the deflector is kept in the target color bits.
  */
 class Tile{
     private: 
-        bool topWall, bottomWall, leftWall, rightWall;
-        bool hasTarget;
-        bool hasCorner;
-        bool hasSpecialTarget;
-        bool hasRobot;
-        bool isCentralTile;
-        char targetColor;
-        char targetSymbol;
-        char robotColor;
-        int positionX;
-        int positionY;
+        // Walls in the low nibble (1 = top, 2 = right, 4 = bottom, 8 = left) and the tile flags in the high nibble
+        unsigned char walls : 4;
+        unsigned char hasTarget : 1;
+        unsigned char hasCorner : 1;
+        unsigned char hasSpecialTarget : 1;
+        unsigned char isCentralTile : 1;
+        // Color and symbol codes (see COLOR_CODES and SYMBOL_CODES in tile.cpp) and the diagonal deflector code (see DEFLECTOR_CODES)
+        unsigned char targetColor : 3;
+        unsigned char targetSymbol : 3;
+        unsigned char deflector : 2;
 
     public:
         Tile();
-        Tile(bool t, bool b, bool l, bool r, bool hasT, bool hasC, bool hasSC, bool hasR, bool isCentral, char tColor, char tSymbol, char rColor, int x, int y);
+        Tile(bool t, bool b, bool l, bool r, bool hasT, bool hasC, bool hasSC, bool isCentral, char tColor, char tSymbol);
         bool checkHasWall();
         bool checkHasTopWall();
         bool checkHasBottomWall();
@@ -44,11 +45,9 @@ class Tile{
         bool checkHasTarget();
         bool checkHasCorner();
         bool checkHasSpecialTarget();   
-        bool checkHasRobot();
         bool checkIsCentralTile();
         char getTargetColor();
         char getTargetSymbol();
-        char getRobotColor();
         void setTopWall(bool t);
         void setBottomWall(bool b);
         void setLeftWall(bool l);
@@ -56,15 +55,14 @@ class Tile{
         void setHasTarget(bool t);
         void setHasCorner(bool c);
         void setHasSpecialTarget(bool sc);
-        void setHasRobot(bool r);
         void setIsCentralTile(bool c);
         void setTargetColor(char c);
         void setTargetSymbol(char s);
-        void setRobotColor(char c);
-        void setX(int x);
-        void setY(int y);
-        int getX();
-        int getY();
+        unsigned char getWalls();
+        void setWall(int direction, bool w);
+        char getDeflector();
+        char getDeflectorColor();
+        void setDeflector(char d, char color);
 };
 
 #endif // TILE_H
\ No newline at end of file
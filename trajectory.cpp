@@ -0,0 +1,88 @@
+/**
+ * @file trajectory.cpp
+ * @author Bastien
+ * @brief Class for the precomputed robot paths of the diagonal variant (Implementation File)
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+#include "trajectory.h"
+
+/**
+ * @brief Construct a new TrajectoryTable:: TrajectoryTable object with an empty path everywhere
+ *
+ * @param cellCount The number of cells of the board
+ */
+TrajectoryTable::TrajectoryTable(int cellCount){
+    this->cellCount = cellCount;
+    this->trajectories.assign((DEFLECTOR_COLOR_COUNT + 1) * cellCount * 4, {0, 0, false});
+}
+
+/**
+ * @brief The colorIndex function returns the index of a robot color in the table
+ *
+ * @param color
+ * @return The index in DEFLECTOR_COLORS, or DEFLECTOR_COLOR_COUNT for any other color, which every deflector turns
+ */
+int TrajectoryTable::colorIndex(char color){
+    for(int i = 0; i < DEFLECTOR_COLOR_COUNT; i++){
+        if(DEFLECTOR_COLORS[i] == color){
+            return i;
+        }
+    }
+    return DEFLECTOR_COLOR_COUNT;
+}
+
+/**
+ * @brief The addPath function stores the path of a robot of a color leaving a cell in a direction
+ *
+ * @param color The index of the color of the robot
+ * @param cell The starting cell
+ * @param direction 0 = N, 1 = E, 2 = S, 3 = W
+ * @param path The cells of the path, in order, without the starting cell
+ * @param bent true if the path went through a deflector that turned the robot
+ */
+void TrajectoryTable::addPath(int color, int cell, int direction, const vector<uint16_t>& path, bool bent){
+    Trajectory& trajectory = this->trajectories[(color * this->cellCount + cell) * 4 + direction];
+    trajectory.start = this->cells.size();
+    trajectory.length = path.size();
+    trajectory.bent = bent;
+    this->cells.insert(this->cells.end(), path.begin(), path.end());
+}
+
+/**
+ * @brief The get function returns the path of a robot of a color leaving a cell in a direction
+ *
+ * @param color The index of the color of the robot
+ * @param cell The starting cell
+ * @param direction 0 = N, 1 = E, 2 = S, 3 = W
+ * @return const Trajectory&
+ */
+const Trajectory& TrajectoryTable::get(int color, int cell, int direction) const{
+    return this->trajectories[(color * this->cellCount + cell) * 4 + direction];
+}
+
+/**
+ * @brief The getCell function returns a cell of a path
+ *
+ * @param trajectory
+ * @param i The index of the cell in the path, from 0 to length - 1
+ * @return int
+ */
+int TrajectoryTable::getCell(const Trajectory& trajectory, int i) const{
+    return this->cells[trajectory.start + i];
+}
+
+/**
+ * @brief The getEnd function returns the cell where a path ends
+ *
+ * @param trajectory
+ * @param cell The starting cell of the path
+ * @return The last cell of the path, or the starting cell if the path is empty
+ */
+int TrajectoryTable::getEnd(const Trajectory& trajectory, int cell) const{
+    return trajectory.length == 0 ? cell : this->cells[trajectory.start + trajectory.length - 1];
+}
@@ -0,0 +1,56 @@
+/**
+ * @file trajectory.h
+ * @author Bastien
+ * @brief Class for the precomputed robot paths of the diagonal variant
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+#ifndef TRAJECTORY_H
+#define TRAJECTORY_H
+
+#include <cstdint>
+#include <vector>
+
+using namespace std;
+
+/**
+ * The robot colors that deflectors can have, one table of trajectories is kept for each of them and one more for robots of any other color.
+ */
+const char DEFLECTOR_COLORS[] = "RGBYS";
+const int DEFLECTOR_COLOR_COUNT = 5;
+
+/**
+ * @brief The path of a robot leaving a cell in a direction, counting only the walls and the deflectors.
+ * @details The cells of the path, in order and without the starting cell, are stored in TrajectoryTable. A straight path stays on one row or column, a bent one went through at least one deflector.
+ */
+struct Trajectory{
+    uint32_t start;
+    uint16_t length;
+    bool bent;
+};
+
+/**
+ * @brief The TrajectoryTable class holds, for each robot color, the path followed from every cell in every direction on a board with diagonal deflectors.
+ * @details A deflector lets robots of its own color go straight through and turns the other robots by 90 degrees. The paths depend only on the walls and the deflectors, so they are computed once per board and a slide is a table lookup: the robots in the way are then found along the stored path.
+ * The table is immutable once built and shared between the board and its snapshots.
+ */
+class TrajectoryTable{
+    private:
+        int cellCount;
+        vector<Trajectory> trajectories;
+        vector<uint16_t> cells;
+
+    public:
+        TrajectoryTable(int cellCount);
+        static int colorIndex(char color);
+        void addPath(int color, int cell, int direction, const vector<uint16_t>& path, bool bent);
+        const Trajectory& get(int color, int cell, int direction) const;
+        int getCell(const Trajectory& trajectory, int i) const;
+        int getEnd(const Trajectory& trajectory, int cell) const;
+};
+
+#endif // TRAJECTORY_H